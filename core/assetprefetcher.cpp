@@ -0,0 +1,113 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QRunnable>
+#include <QImageReader>
+#include <QFileInfo>
+
+#include "assetprefetcher.h"
+#include "slideshow.h"
+#include "slide.h"
+#include "configuration.h"
+
+class DecodeTask : public QRunnable
+{
+public:
+	DecodeTask(AssetPrefetcher *prefetcher, const QString &key, const QString &path, const QByteArray &data)
+		: prefetcher(prefetcher), key(key), path(path), data(data) {}
+
+	virtual void run()
+	{
+		QMetaObject::invokeMethod(prefetcher, "deliver", Qt::QueuedConnection, Q_ARG(QString, key), Q_ARG(QList<QImage>, AssetPrefetcher::decode(data, path)));
+	}
+
+private:
+	AssetPrefetcher *prefetcher;
+	const QString key;
+	const QString path;
+	const QByteArray data;
+};
+
+AssetPrefetcher::AssetPrefetcher(Slideshow *slideshow, QObject *parent) : QObject(parent)
+{
+	qRegisterMetaType<QList<QImage> >("QList<QImage>");
+	this->slideshow = slideshow;
+}
+
+AssetPrefetcher::~AssetPrefetcher()
+{
+	pool.clear();
+	pool.waitForDone();
+}
+
+void AssetPrefetcher::prefetch(Slide *slide)
+{
+	const QList<QByteArray> formats = QImageReader::supportedImageFormats();
+	foreach(const QString &path, slide->assets())
+	{
+		// media files are opened by their backend when they are played
+		if(!formats.contains(QFileInfo(path).suffix().toLower().toLatin1()))
+			continue;
+
+		const QString key = slideshow->imageKey(path);
+		if(pending.contains(key) || slideshow->hasImage(key))
+			continue;
+
+		// embedded assets are read here: the reader is only shared with the GUI thread,
+		// and its mapping may be released by a save while the task is queued
+		const QByteArray data = slideshow->asset(path);
+		pending << key;
+		pool.start(new DecodeTask(this, key, path, QByteArray(data.constData(), data.size())));
+	}
+}
+
+bool AssetPrefetcher::isBusy() const
+{
+	return !pending.isEmpty();
+}
+
+QList<QImage> AssetPrefetcher::decode(const QByteArray &data, const QString &path)
+{
+	QImage image;
+	if(data.isEmpty() || !image.loadFromData(data))
+		image.load(path);
+
+	QList<QImage> levels;
+	if(image.isNull())
+		return levels;
+
+	// the levels the image cache would build on first use are scaled here as well
+	levels << image.convertToFormat(QImage::Format_ARGB32_Premultiplied);
+	while(levels.last().width() >= PREFETCH_LEVEL_SIZE * 2 && levels.last().height() >= PREFETCH_LEVEL_SIZE * 2)
+	{
+		const QImage &last = levels.last();
+		levels << last.scaled(last.width() / 2, last.height() / 2, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+	}
+
+	return levels;
+}
+
+void AssetPrefetcher::deliver(const QString &key, const QList<QImage> &levels)
+{
+	pending.remove(key);
+	if(!levels.isEmpty())
+		slideshow->insertImage(key, levels);
+
+	if(pending.isEmpty())
+		emit finished();
+}
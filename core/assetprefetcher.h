@@ -0,0 +1,54 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef ASSETPREFETCHER_H
+#define ASSETPREFETCHER_H
+
+#include <QObject>
+#include <QThreadPool>
+#include <QSet>
+#include <QImage>
+
+class Slideshow;
+class Slide;
+
+class AssetPrefetcher : public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit AssetPrefetcher(Slideshow *slideshow, QObject *parent = 0);
+	~AssetPrefetcher();
+	void prefetch(Slide *slide);
+	bool isBusy() const;
+
+	static QList<QImage> decode(const QByteArray &data, const QString &path);
+
+signals:
+	void finished();
+
+private slots:
+	void deliver(const QString &key, const QList<QImage> &levels);
+
+private:
+	Slideshow *slideshow;
+	QThreadPool pool;
+	QSet<QString> pending;
+};
+
+#endif // ASSETPREFETCHER_H
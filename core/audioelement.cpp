@@ -16,21 +16,13 @@
  * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
  */
 
-#include <QMediaPlaylist>
-
 #include "audioelement.h"
+#include "slideshow.h"
 #include "propertymanager.h"
 #include "configuration.h"
 
-AudioElement::AudioElement() : SlideElement()
-{
-	playbackFinished = false;
-	setValue(QStringLiteral("volume"), 100);
-}
-
-QString AudioElement::previewUrl() const
+AudioElement::AudioElement() : MediaElement()
 {
-	return getValue(QStringLiteral("src")).toString();
 }
 
 QGraphicsItem *AudioElement::render(const bool interactive)
@@ -38,15 +30,8 @@ QGraphicsItem *AudioElement::render(const bool interactive)
 	if(interactive || !getValue(QStringLiteral("visible")).toBool())
 		return 0;
 
-	player = new QMediaPlayer;
-	player->setVolume(getValue(QStringLiteral("volume")).toInt());
-	connect(player, &QMediaPlayer::stateChanged, this, &AudioElement::stateChanged);
-
-	QMediaPlaylist *playlist = new QMediaPlaylist(player);
-	playlist->addMedia(QUrl::fromLocalFile(getValue(QStringLiteral("src")).toString()));
-	if(getValue(QStringLiteral("loop")).toBool())
-		playlist->setPlaybackMode(QMediaPlaylist::CurrentItemInLoop);
-	player->setPlaylist(playlist);
+	// a player is attached once the viewer prepares or plays the slide
+	releasePlayer();
 	return 0;
 }
 
@@ -91,37 +76,3 @@ PropertyList AudioElement::getProperties() const
 		<< visible
 		<< group;
 }
-
-void AudioElement::stateChanged(QMediaPlayer::State state)
-{
-	if(state == QMediaPlayer::StoppedState)
-		playbackFinished = true;
-}
-
-void AudioElement::play()
-{
-	if(!playbackFinished)
-		player->play();
-}
-
-void AudioElement::pause()
-{
-	if(!playbackFinished)
-		player->pause();
-}
-
-void AudioElement::stop()
-{
-	player->stop();
-	playbackFinished = false;
-}
-
-void AudioElement::toggleMute()
-{
-	player->setMuted(!player->isMuted());
-}
-
-void AudioElement::destroy()
-{
-	player->deleteLater();
-}
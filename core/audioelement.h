@@ -19,32 +19,16 @@
 #ifndef AudioElement_H
 #define AudioElement_H
 
-#include <QMediaPlayer>
-#include "slideelement.h"
+#include "mediaelement.h"
 
-class AudioElement : public SlideElement
+class AudioElement : public MediaElement
 {
 	Q_OBJECT
 
 public:
 	AudioElement();
-	virtual QString previewUrl() const;
 	virtual QGraphicsItem *render(const bool interactive);
 	virtual PropertyList getProperties() const;
-
-public slots:
-	virtual void play();
-	virtual void pause();
-	virtual void stop();
-	virtual void toggleMute();
-	virtual void destroy();
-
-private slots:
-	void stateChanged(QMediaPlayer::State state);
-
-protected:
-	QMediaPlayer *player;
-	bool playbackFinished;
 };
 
 Q_DECLARE_METATYPE(AudioElement)
@@ -0,0 +1,156 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QCoreApplication>
+#include <QCommandLineParser>
+#include <QFileInfo>
+#include <QDir>
+#include <QTextStream>
+
+#include "batchexporter.h"
+#include "slideshow.h"
+#include "slide.h"
+#include "slideshowreader.h"
+#include "sliderenderer.h"
+#include "imageelement.h"
+#include "rectelement.h"
+#include "ellipseelement.h"
+#include "textelement.h"
+#include "videoelement.h"
+#include "audioelement.h"
+#include "lineelement.h"
+
+BatchExporter::BatchExporter(QObject *parent) : QObject(parent)
+{
+}
+
+bool BatchExporter::isRequested(int argc, char *argv[])
+{
+	// checked before the application exists to select the offscreen platform
+	for(int index = 1; index < argc; index++)
+	{
+		if(qstrcmp(argv[index], "--export") == 0)
+			return true;
+	}
+
+	return false;
+}
+
+int BatchExporter::exec(const QStringList &arguments)
+{
+	QCommandLineParser parser;
+	parser.setApplicationDescription(tr("Exporte les diapositives d'un diaporama en images sans afficher de fenêtre."));
+	parser.addHelpOption();
+	parser.addPositionalArgument(QStringLiteral("file"), tr("Diaporama à exporter."));
+
+	const QCommandLineOption exportOption(QStringLiteral("export"), tr("Active l'exportation en ligne de commande."));
+	const QCommandLineOption outputOption(QStringLiteral("output"), tr("Dossier de destination."), tr("dossier"), QDir::currentPath());
+	const QCommandLineOption formatOption(QStringLiteral("format"), tr("Format des images."), tr("format"), QStringLiteral("png"));
+	const QCommandLineOption qualityOption(QStringLiteral("quality"), tr("Qualité des images (0 à 100)."), tr("qualité"), QStringLiteral("100"));
+	const QCommandLineOption templateOption(QStringLiteral("template"), tr("Nom des fichiers (%n : nom, %i : numéro, %s : diaporama, %f : format)."), tr("modèle"), tr("Diapositive %i - %n.%f"));
+	const QCommandLineOption fromOption(QStringLiteral("from"), tr("Première diapositive à exporter."), tr("numéro"), QStringLiteral("1"));
+	const QCommandLineOption toOption(QStringLiteral("to"), tr("Dernière diapositive à exporter."), tr("numéro"));
+	const QCommandLineOption noPluginsOption(QStringLiteral("noplugins"), tr("Ignoré : les extensions ne sont jamais chargées lors de l'exportation."));
+
+	parser.addOption(exportOption);
+	parser.addOption(outputOption);
+	parser.addOption(formatOption);
+	parser.addOption(qualityOption);
+	parser.addOption(templateOption);
+	parser.addOption(fromOption);
+	parser.addOption(toOption);
+	parser.addOption(noPluginsOption);
+	parser.process(arguments);
+
+	if(parser.positionalArguments().size() != 1)
+	{
+		printError(tr("Un seul diaporama doit être spécifié."));
+		return 1;
+	}
+
+	const QString fileName = parser.positionalArguments().first();
+	const QString directory = parser.value(outputOption);
+	const QString format = parser.value(formatOption);
+	const QString fileTemplate = parser.value(templateOption);
+	const int quality = parser.value(qualityOption).toInt();
+
+	if(!QDir().mkpath(directory))
+	{
+		printError(tr("Impossible de créer le dossier %1.").arg(directory));
+		return 1;
+	}
+
+	QList<int> elementTypes;
+	elementTypes
+		<< qRegisterMetaType<RectElement>()
+		<< qRegisterMetaType<EllipseElement>()
+		<< qRegisterMetaType<LineElement>()
+		<< qRegisterMetaType<TextElement>()
+		<< qRegisterMetaType<ImageElement>()
+		<< qRegisterMetaType<VideoElement>()
+		<< qRegisterMetaType<AudioElement>();
+
+	SlideshowReader *reader = new SlideshowReader(fileName);
+	reader->setElementTypes(elementTypes);
+	if(!reader->open() || !reader->readIndex())
+	{
+		printError(tr("Impossible d'ouvrir le diaporama %1 (erreur %2).").arg(fileName).arg(reader->error()));
+		delete reader;
+		return 1;
+	}
+
+	Slideshow slideshow;
+	slideshow.setValues(reader->metadata());
+	slideshow.setSource(reader);
+	foreach(const SlideChunk &chunk, reader->chunks())
+		slideshow.createSlide(chunk);
+
+	const int slideCount = slideshow.getSlides().size();
+	const int from = parser.value(fromOption).toInt() - 1;
+	const int to = parser.isSet(toOption) ? parser.value(toOption).toInt() - 1 : slideCount - 1;
+	if(from < 0 || to >= slideCount || from > to)
+	{
+		printError(tr("La sélection doit être comprise entre 1 et %1.").arg(slideCount));
+		return 1;
+	}
+
+	const QString slideshowName = QFileInfo(fileName).baseName();
+	SlideRenderer renderer(slideshow.getValue(QStringLiteral("size")).toSize());
+	for(int index = from; index <= to; index++)
+	{
+		Slide *slide = slideshow.getSlide(index);
+		const QImage image = renderer.render(slide);
+		const QString outputName = SlideRenderer::fileName(fileTemplate, slide, index, slideshowName, format);
+
+		// only the slide being exported stays in memory
+		slide->unload();
+
+		if(!image.save(directory + "/" + outputName, format.toLocal8Bit().data(), quality))
+		{
+			printError(tr("Une erreur s'est produite lors de l'enregistrement de %1.").arg(outputName));
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+void BatchExporter::printError(const QString &message) const
+{
+	QTextStream(stderr) << QCoreApplication::applicationName() << ": " << message << endl;
+}
@@ -23,6 +23,16 @@ HEADERS += \
 	lineelement.h \
 	plugindialog.h \
 	resizedialog.h \
+	slideshowloader.h \
+	journalwriter.h \
+	batchexporter.h \
+	thumbnailrenderer.h \
+	thumbnailcache.h \
+	slideresidency.h \
+	assetprefetcher.h \
+	transitionwidget.h \
+	mediaplayerpool.h \
+	mediaelement.h \
 	../shared/plugin.h \
 
 SOURCES += \
@@ -39,6 +49,16 @@ SOURCES += \
 	lineelement.cpp \
 	plugindialog.cpp \
 	resizedialog.cpp \
+	slideshowloader.cpp \
+	journalwriter.cpp \
+	batchexporter.cpp \
+	thumbnailrenderer.cpp \
+	thumbnailcache.cpp \
+	slideresidency.cpp \
+	assetprefetcher.cpp \
+	transitionwidget.cpp \
+	mediaplayerpool.cpp \
+	mediaelement.cpp \
 
 FORMS += \
 	mainwindow.ui \
@@ -23,15 +23,26 @@ QGraphicsItem *EllipseElement::render(const bool interactive)
 	if(!getValue(QStringLiteral("visible")).toBool())
 		return 0;
 
+	GraphicsEllipseItem *item = new GraphicsEllipseItem(interactive, this);
+	updateItem(item);
+
+	return item;
+}
+
+bool EllipseElement::updateItem(QGraphicsItem *graphicsItem)
+{
+	GraphicsEllipseItem *item = dynamic_cast<GraphicsEllipseItem *>(graphicsItem);
+	if(item == 0 || !getValue(QStringLiteral("visible")).toBool())
+		return false;
+
 	QPen pen(penStyle());
 	pen.setColor(getValue(QStringLiteral("borderColor")).value<QColor>());
 	pen.setWidth(getValue(QStringLiteral("borderSize")).toInt());
 
-	GraphicsEllipseItem *item = new GraphicsEllipseItem(interactive, this);
 	item->setBrush(QBrush(getValue(QStringLiteral("color")).value<QColor>(), brushStyle()));
 	item->setPen(pen);
 	item->setRect(QRect(QPoint(), getValue(QStringLiteral("size")).toSize()));
 	item->setPos(getValue(QStringLiteral("position")).toPoint());
 
-	return item;
+	return true;
 }
@@ -31,6 +31,7 @@ class EllipseElement : public RectElement
 public:
 	EllipseElement() : RectElement() {}
 	virtual QGraphicsItem *render(const bool interactive);
+	virtual bool updateItem(QGraphicsItem *item);
 };
 
 class GraphicsEllipseItem : public QGraphicsEllipseItem
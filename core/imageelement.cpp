@@ -17,6 +17,7 @@
  */
 
 #include <QIcon>
+#include <QPainter>
 
 #include "imageelement.h"
 #include "slideshow.h"
@@ -29,6 +30,12 @@ ImageElement::ImageElement() : SlideElement()
 	setValue(QStringLiteral("size"), QSize(400, 300));
 }
 
+QStringList ImageElement::assets() const
+{
+	const QString src = getValue(QStringLiteral("src")).toString();
+	return src.isEmpty() ? QStringList() : QStringList(src);
+}
+
 QGraphicsItem *ImageElement::render(const bool interactive)
 {
 	if(!getValue(QStringLiteral("visible")).toBool())
@@ -37,7 +44,7 @@ QGraphicsItem *ImageElement::render(const bool interactive)
 	const QSize size = getValue(QStringLiteral("size")).toSize();
 	const QPoint pos = getValue(QStringLiteral("position")).toPoint();
 
-	const QPixmap pixmap(getValue(QStringLiteral("src")).toString());
+	const QPixmap pixmap = slideshow()->pixmap(getValue(QStringLiteral("src")).toString(), size);
 	if(pixmap.isNull())
 	{
 		MissingImagePlaceholderItem *item = new MissingImagePlaceholderItem(interactive, this);
@@ -62,16 +69,47 @@ QGraphicsItem *ImageElement::render(const bool interactive)
 	}
 	else
 	{
-		const QPixmap spixmap = pixmap.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
-
 		GraphicsPixmapItem *item = new GraphicsPixmapItem(interactive, this);
-		item->setPixmap(spixmap);
-		item->setPos(getValue(QStringLiteral("position")).toPoint());
+		updateItem(item);
 
 		return item;
 	}
 }
 
+bool ImageElement::updateItem(QGraphicsItem *graphicsItem)
+{
+	// missing images use a different item, switching between both needs a new one
+	GraphicsPixmapItem *item = dynamic_cast<GraphicsPixmapItem *>(graphicsItem);
+	if(item == 0 || !getValue(QStringLiteral("visible")).toBool())
+		return false;
+
+	const QSize size = getValue(QStringLiteral("size")).toSize();
+	const QPixmap pixmap = slideshow()->pixmap(getValue(QStringLiteral("src")).toString(), size);
+	if(pixmap.isNull())
+		return false;
+
+	item->setPixmap(pixmap.size() == size ? pixmap : pixmap.scaled(size, Qt::IgnoreAspectRatio, Qt::SmoothTransformation));
+	item->setPos(getValue(QStringLiteral("position")).toPoint());
+
+	return true;
+}
+
+void GraphicsPixmapItem::paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget)
+{
+	// scaled down renderings such as thumbnails draw a cached mip level instead of the full pixmap
+	const QRectF rect(offset(), pixmap().size());
+	const QSize deviceSize = painter->worldTransform().mapRect(rect).size().toSize();
+	if(slideElement == 0 || deviceSize.isEmpty() || deviceSize.width() * 2 > pixmap().width() || deviceSize.height() * 2 > pixmap().height())
+		return QGraphicsPixmapItem::paint(painter, option, widget);
+
+	const QPixmap level = slideElement->slideshow()->pixmap(slideElement->getValue(QStringLiteral("src")).toString(), deviceSize);
+	if(level.isNull())
+		return QGraphicsPixmapItem::paint(painter, option, widget);
+
+	painter->setRenderHint(QPainter::SmoothPixmapTransform);
+	painter->drawPixmap(rect, level, level.rect());
+}
+
 PropertyList ImageElement::getProperties() const
 {
 	FilePropertyManager *fileManager = new FilePropertyManager;
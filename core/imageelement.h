@@ -30,7 +30,9 @@ class ImageElement : public SlideElement
 
 public:
 	ImageElement();
+	virtual QStringList assets() const;
 	virtual QGraphicsItem *render(const bool interactive);
+	virtual bool updateItem(QGraphicsItem *item);
 	virtual PropertyList getProperties() const;
 
 protected:
@@ -40,6 +42,9 @@ protected:
 class GraphicsPixmapItem : public QGraphicsPixmapItem
 {
 	GRAPHICS_ITEM(GraphicsPixmapItem, QGraphicsPixmapItem)
+
+public:
+	virtual void paint(QPainter *painter, const QStyleOptionGraphicsItem *option, QWidget *widget);
 };
 
 class MissingImagePlaceholderItem : public QGraphicsRectItem
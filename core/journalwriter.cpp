@@ -0,0 +1,61 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QStandardPaths>
+#include <QDir>
+#include <QFileInfo>
+
+#include "journalwriter.h"
+#include "slideshowwriter.h"
+#include "configuration.h"
+
+JournalWriter::JournalWriter(QObject *parent) : QThread(parent)
+{
+}
+
+QString JournalWriter::journalPath()
+{
+	const QString dataPath = QStandardPaths::writableLocation(QStandardPaths::DataLocation);
+	QDir().mkpath(dataPath);
+
+	return QDir(dataPath).filePath(QStringLiteral(JOURNAL_FILE));
+}
+
+QString JournalWriter::recoveredPath()
+{
+	// a recovered journal is opened from a copy: the journal itself keeps being rewritten
+	return QDir(QFileInfo(journalPath()).path()).filePath(QStringLiteral(RECOVERED_FILE));
+}
+
+void JournalWriter::write(const SlideshowSnapshot &snapshot)
+{
+	if(isRunning())
+		return;
+
+	this->snapshot = snapshot;
+	start(QThread::LowPriority);
+}
+
+void JournalWriter::run()
+{
+	SlideshowWriter writer(journalPath());
+	if(!writer.write(snapshot))
+		emit failed();
+
+	snapshot = SlideshowSnapshot();
+}
@@ -0,0 +1,46 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef JOURNALWRITER_H
+#define JOURNALWRITER_H
+
+#include <QThread>
+
+#include "slidesnapshot.h"
+
+class JournalWriter : public QThread
+{
+	Q_OBJECT
+
+public:
+	explicit JournalWriter(QObject *parent = 0);
+	static QString journalPath();
+	static QString recoveredPath();
+	void write(const SlideshowSnapshot &snapshot);
+
+signals:
+	void failed();
+
+protected:
+	virtual void run();
+
+private:
+	SlideshowSnapshot snapshot;
+};
+
+#endif // JOURNALWRITER_H
@@ -31,6 +31,18 @@ QGraphicsItem *LineElement::render(const bool interactive)
 	if(!getValue(QStringLiteral("visible")).toBool())
 		return 0;
 
+	GraphicsLineItem *item = new GraphicsLineItem(interactive, this);
+	updateItem(item);
+
+	return item;
+}
+
+bool LineElement::updateItem(QGraphicsItem *graphicsItem)
+{
+	GraphicsLineItem *item = dynamic_cast<GraphicsLineItem *>(graphicsItem);
+	if(item == 0 || !getValue(QStringLiteral("visible")).toBool())
+		return false;
+
 	Qt::PenStyle penStyle;
 	switch(getValue(QStringLiteral("style")).toInt())
 	{
@@ -55,12 +67,11 @@ QGraphicsItem *LineElement::render(const bool interactive)
 	pen.setColor(getValue(QStringLiteral("color")).value<QColor>());
 	pen.setWidth(getValue(QStringLiteral("size")).toInt());
 
-	GraphicsLineItem *item = new GraphicsLineItem(interactive, this);
 	item->setPen(pen);
 	item->setPos(getValue(QStringLiteral("position")).toPoint());
 	item->setLine(QLine(QPoint(0, getValue(QStringLiteral("start")).toInt()), getValue(QStringLiteral("stop")).toPoint()));
 
-	return item;
+	return true;
 }
 
 PropertyList LineElement::getProperties() const
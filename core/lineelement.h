@@ -31,6 +31,7 @@ class LineElement : public SlideElement
 public:
 	LineElement();
 	virtual QGraphicsItem *render(const bool interactive);
+	virtual bool updateItem(QGraphicsItem *item);
 	virtual PropertyList getProperties() const;
 };
 
@@ -22,10 +22,15 @@
 #include <QTranslator>
 
 #include "mainwindow.h"
+#include "batchexporter.h"
 #include "configuration.h"
 
 int main(int argc, char *argv[])
 {
+	const bool headless = BatchExporter::isRequested(argc, argv);
+	if(headless && qgetenv("QT_QPA_PLATFORM").isEmpty())
+		qputenv("QT_QPA_PLATFORM", "offscreen");
+
 	QApplication app(argc, argv);
 	app.setApplicationName("cfiSlides");
 	app.setApplicationVersion(CFISLIDES_VERSION);
@@ -44,6 +49,9 @@ int main(int argc, char *argv[])
 	if(!QIcon::hasThemeIcon(TEST_ICON))
 		QIcon::setThemeName(FALLBACK_THEME);
 
+	if(headless)
+		return BatchExporter().exec(app.arguments());
+
 	QStringList arguments = app.arguments();
 
 	bool disablePlugins = arguments.contains("--noplugins");
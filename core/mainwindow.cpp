@@ -33,8 +33,10 @@
 #include <QActionGroup>
 #include <QMediaPlayer>
 #include <QJsonObject>
-#include <QProgressDialog>
+#include <QProgressBar>
+#include <QToolButton>
 #include <QProcess>
+#include <QLockFile>
 
 #include "mainwindow.h"
 #include "ui_mainwindow.h"
@@ -42,6 +44,12 @@
 #include "slideshow.h"
 #include "slide.h"
 #include "slideelement.h"
+#include "slideshowreader.h"
+#include "slideshowwriter.h"
+#include "slideshowloader.h"
+#include "journalwriter.h"
+#include "thumbnailrenderer.h"
+#include "slideresidency.h"
 #include "imageelement.h"
 #include "rectelement.h"
 #include "ellipseelement.h"
@@ -155,11 +163,74 @@ MainWindow::MainWindow(const QString openFile, const bool disablePlugins, QWidge
 
 	this->slideshow = 0;
 	this->newSlideshowCount = 0;
+	this->loadErrors = 0;
+	this->loader = 0;
+	this->viewer = 0;
+
+	thumbnails = new ThumbnailRenderer(this);
+
+	// a single view shows the scene of the current slide, scenes are recycled when slides leave the loaded window
+	editorView = new GraphicsView(0);
+	editorView->setContextMenuPolicy(Qt::CustomContextMenu);
+	connect(editorView, &QWidget::customContextMenuRequested, this, &MainWindow::displayViewContextMenu);
+	ui->displayWidget->addWidget(editorView);
+
+	offscreenScene = new QGraphicsScene(this);
+	offscreenScene->setItemIndexMethod(QGraphicsScene::NoIndex);
+
+	residency = new SlideResidency(this);
+	residency->setBudget(QSettings().value(QStringLiteral("memoryBudget"), MEMORY_BUDGET).toLongLong() << 20);
+	connect(residency, &SlideResidency::populate, this, &MainWindow::populateSlide);
+	connect(residency, &SlideResidency::evict, this, &MainWindow::evictSlide);
+
+	connect(thumbnails, &ThumbnailRenderer::thumbnailReady, this, &MainWindow::thumbnailReady);
+
+	loadProgress = new QProgressBar(this);
+	loadProgress->setMaximumWidth(200);
+	loadProgress->hide();
+	statusBar()->addPermanentWidget(loadProgress);
+
+	loadCancelButton = new QToolButton(this);
+	loadCancelButton->setIcon(ICON_T("process-stop"));
+	loadCancelButton->setToolTip(tr("Annuler le chargement"));
+	loadCancelButton->setAutoRaise(true);
+	loadCancelButton->hide();
+	statusBar()->addPermanentWidget(loadCancelButton);
+	connect(loadCancelButton, &QToolButton::clicked, this, &MainWindow::cancelLoading);
 
 	if(!disablePlugins)
 		loadPlugins();
 
-	if(openFile.isEmpty() || !openSlideshow(openFile))
+	// the journal belongs to the first running instance, a stale lock means it crashed
+	journal = new JournalWriter(this);
+	journalOutdated = false;
+	connect(journal, &JournalWriter::failed, this, &MainWindow::journalFailed);
+	journalLock = new QLockFile(JournalWriter::journalPath() + QStringLiteral(".lock"));
+	journalLock->setStaleLockTime(0);
+
+	bool recover = false;
+	if(journalLock->tryLock() && QFile::exists(JournalWriter::journalPath()))
+	{
+		recover = QMessageBox::question(this, qApp->applicationName(), tr("%1 n'a pas été fermé correctement. Voulez-vous récupérer les changements non enregistrés ?").arg(qApp->applicationName()), QMessageBox::Yes | QMessageBox::No, QMessageBox::Yes) == QMessageBox::Yes;
+		if(!recover)
+			QFile::remove(JournalWriter::journalPath());
+	}
+
+	// the journal is moved aside before it is opened, autosaves then start a new one
+	if(recover)
+	{
+		QFile::remove(JournalWriter::recoveredPath());
+		recover = QFile::rename(JournalWriter::journalPath(), JournalWriter::recoveredPath());
+	}
+
+	autosaveTimer.setInterval(AUTOSAVE_INTERVAL);
+	connect(&autosaveTimer, &QTimer::timeout, this, &MainWindow::autosave);
+	if(journalLock->isLocked())
+		autosaveTimer.start();
+
+	if(recover)
+		openSlideshow(JournalWriter::recoveredPath());
+	else if(openFile.isEmpty() || !openSlideshow(openFile))
 	{
 		newSlideshow();
 		statusBar()->showMessage(tr("Merci d'utiliser %1 !").arg(qApp->applicationName()), STATUS_TIMEOUT);
@@ -169,6 +240,15 @@ MainWindow::MainWindow(const QString openFile, const bool disablePlugins, QWidge
 	moveFinishTimer.setSingleShot(true);
 	connect(&moveFinishTimer, &QTimer::timeout, this, &MainWindow::moveFinishTimerTimeout);
 
+	// modifications are coalesced: a slide is rebuilt at most once per frame and its icon once editing pauses
+	renderTimer.setInterval(RENDER_INTERVAL);
+	renderTimer.setSingleShot(true);
+	connect(&renderTimer, &QTimer::timeout, this, &MainWindow::flushRenders);
+
+	iconTimer.setInterval(ICON_UPDATE_DELAY);
+	iconTimer.setSingleShot(true);
+	connect(&iconTimer, &QTimer::timeout, this, &MainWindow::flushIconUpdates);
+
 	if(disablePlugins)
 	{
 		ui->actionPlugins->setEnabled(false);
@@ -179,6 +259,10 @@ MainWindow::MainWindow(const QString openFile, const bool disablePlugins, QWidge
 
 MainWindow::~MainWindow()
 {
+	abortLoading();
+	journal->wait();
+	delete journalLock;
+
 	clearClipboard();
 	unloadPlugins();
 	delete ui;
@@ -192,7 +276,8 @@ Slideshow *MainWindow::getSlideshow() const
 void MainWindow::setWindowModified(const bool modified)
 {
 	QMainWindow::setWindowModified(modified);
-	ui->actionSave->setEnabled(modified);
+	ui->actionSave->setEnabled(modified && loader == 0);
+	journalOutdated = modified;
 }
 
 void MainWindow::setWindowTitle(const QString &fileName)
@@ -211,6 +296,10 @@ void MainWindow::newSlideshow()
 	this->setWindowTitle(tr("Nouveau diaporama %1").arg(++newSlideshowCount));
 
 	this->slideshow = new Slideshow;
+	ui->actionEmbedMedia->setChecked(false);
+	ui->actionCompressSlides->setChecked(false);
+	ui->actionAutoAdvance->setChecked(false);
+	ui->actionLoop->setChecked(false);
 	createEmptySlide();
 
 	this->setWindowModified(false);
@@ -236,108 +325,227 @@ bool MainWindow::openSlideshow(const QString &knowPath)
 	if(this->slideshow != 0 && !closeSlideshow())
 		return false;
 
-	QFile file(newFile);
-	if(!file.open(QIODevice::ReadOnly))
+	loadErrors = 0;
+
+	this->slideshow = new Slideshow;
+	this->slideActions->setEnabled(false);
+	ui->actionSave->setEnabled(false);
+	ui->actionSaveAs->setEnabled(false);
+
+	// the slides are parsed by a worker thread and appended to the list as they arrive
+	loader = new SlideshowLoader(newFile, registeredTypes.keys(), this);
+	connect(loader, &SlideshowLoader::indexLoaded, this, &MainWindow::slideshowIndexLoaded);
+	connect(loader, &SlideshowLoader::slidesLoaded, this, &MainWindow::slidesLoaded);
+	connect(loader, &SlideshowLoader::failed, this, &MainWindow::slideshowLoadFailed);
+	connect(loader, &SlideshowLoader::unknownElement, this, &MainWindow::unknownElementFound);
+	connect(loader, &SlideshowLoader::corruptSlide, this, &MainWindow::corruptSlideFound);
+	connect(loader, &QThread::finished, this, &MainWindow::slideshowLoadFinished);
+	connect(loader, &QThread::finished, loader, &QObject::deleteLater);
+
+	const QString fileName = QFileInfo(newFile).fileName();
+	this->setWindowTitle(fileName);
+	this->setWindowFilePath(newFile);
+
+	loadProgress->setValue(0);
+	loadProgress->setMaximum(0);
+	loadProgress->show();
+	loadCancelButton->show();
+	statusBar()->showMessage(tr("Chargement de %1...").arg(fileName));
+
+	loader->start();
+	return true;
+}
+
+void MainWindow::slideshowIndexLoaded(const QVariantMap &metadata, const int slidesCount)
+{
+	if(sender() != loader)
+		return;
+
+	this->slideshow->setValues(metadata);
+
+	// a recovery journal remembers the file it was made for, and the file its unchanged slides are read from
+	QString sourceFile = loader->fileName();
+	if(metadata.contains(QStringLiteral("recoveryChunks")))
 	{
-		QMessageBox::critical(this, qApp->applicationName(), tr("Impossible de lire le contenu du fichier."));
-		return false;
+		sourceFile = metadata.value(QStringLiteral("recoverySource")).toString();
+		this->slideshow->setValue(QStringLiteral("embedAssets"), metadata.value(QStringLiteral("recoveryEmbedAssets")));
+		this->slideshow->unsetValue(QStringLiteral("recoverySource"));
+		this->slideshow->unsetValue(QStringLiteral("recoveryIndexOffset"));
+		this->slideshow->unsetValue(QStringLiteral("recoveryEmbedAssets"));
+		this->slideshow->unsetValue(QStringLiteral("recoveryChunks"));
 	}
 
-	int errorsCount = 0;
+	ui->actionEmbedMedia->setChecked(this->slideshow->getValue(QStringLiteral("embedAssets")).toBool());
+	ui->actionCompressSlides->setChecked(metadata.value(QStringLiteral("compression")).toInt() != SlideChunk::NoCodec);
+	ui->actionAutoAdvance->setChecked(metadata.value(QStringLiteral("autoAdvance")).toBool());
+	ui->actionLoop->setChecked(metadata.value(QStringLiteral("loop")).toBool());
 
-	QDataStream in(&file);
-	QString fileAppName;
-	in >> fileAppName;
-	if(fileAppName != qApp->applicationName())
+	if(metadata.contains(QStringLiteral("recoveryPath")))
 	{
-		QMessageBox::critical(this, qApp->applicationName(), tr("Le fichier demandé ne peut pas être ouvert avec %1.").arg(qApp->applicationName()));
-		file.close();
-		return false;
+		const QString originalFile = metadata.value(QStringLiteral("recoveryPath")).toString();
+		this->slideshow->unsetValue(QStringLiteral("recoveryPath"));
+		this->setWindowFilePath(originalFile);
+		this->setWindowTitle(originalFile.isEmpty() ? tr("Diaporama récupéré") : QFileInfo(originalFile).fileName());
+		this->setWindowModified(true);
 	}
 
-	QVariantMap metadata;
-	in >> metadata;
-
-	this->slideshow = new Slideshow;
-	this->slideshow->setValues(metadata);
-	this->slideActions->setEnabled(false);
+	SlideshowReader *reader = createReader(sourceFile);
+	if(reader->open() && reader->readIndex())
+		this->slideshow->setSource(reader);
+	else
+		delete reader;
 
-	int slidesCount = 0;
-	in >> slidesCount;
+	loadProgress->setMaximum(slidesCount);
+}
 
-	QProgressDialog *progress = new QProgressDialog(this);
-	progress->setWindowTitle(qApp->applicationName());
-	progress->setWindowFlags(Qt::Dialog | Qt::CustomizeWindowHint | Qt::WindowTitleHint);
-	progress->setCancelButtonText(QString());
-	progress->setLabelText(tr("Chargement et affichage du diaporama en cours..."));
-	progress->setMaximum(slidesCount);
-	progress->open();
+void MainWindow::slidesLoaded(const QList<Slide *> &slides)
+{
+	// batches still queued when the loading was cancelled
+	if(sender() != loader)
+	{
+		qDeleteAll(slides);
+		return;
+	}
 
-	for(int si = 0; si < slidesCount; si++)
+	foreach(Slide *slide, slides)
 	{
-		progress->setValue(si + 1);
+		slide->setSlideshow(this->slideshow);
+		this->slideshow->addSlide(slide);
+		displaySlide(slide);
+	}
 
-		QVariantMap properties;
-		in >> properties;
+	// slides ahead of the current one may have just arrived
+	if(ui->slideList->currentRow() != -1)
+		updateLoadedSlides(ui->slideList->currentRow());
 
-		Slide *slide = slideshow->createSlide();
-		slide->setValues(properties);
+	loadProgress->setValue(this->slideshow->getSlides().size());
+}
 
-		int elementsCount = 0;
-		in >> elementsCount;
-		for(int ei = 0; ei < elementsCount; ei++)
-		{
-			char *type;
-			in >> type;
-
-			QVariantMap properties;
-			in >> properties;
-
-			const int typeId = QMetaType::type(type);
-			if(!registeredTypes.contains(typeId))
-			{
-				if(errorsCount == 0)
-				{
-					QMessageBox::warning(this, qApp->applicationName(),
-						tr("La diapositive %1 contient un élément graphique inconnu (%2@%3). L'élément a été ignoré et sera supprimé au prochain enregistrement.\n\nLes erreurs suivantes ne seront pas rapportés.")
-							.arg(slide->getValue(QStringLiteral("name")).toString())
-							.arg(QString(type).isEmpty() ? tr("Inconnu") : type)
-							.arg(ei)
-					);
-					this->setWindowModified(true);
-				}
-
-				errorsCount++;
-				continue;
-			}
-
-			SlideElement *element = (SlideElement *)QMetaType::create(typeId);
-			element->setValues(properties);
-			slide->addElement(element);
-		}
+void MainWindow::slideshowLoadFailed(const int error)
+{
+	if(sender() != loader)
+		return;
 
-		displaySlide(slide);
+	abortLoading();
+
+	switch(error)
+	{
+		case SlideshowReader::OpenError:
+			QMessageBox::critical(this, qApp->applicationName(), tr("Impossible de lire le contenu du fichier."));
+			break;
+		case SlideshowReader::VersionError:
+			QMessageBox::critical(this, qApp->applicationName(), tr("Le fichier demandé a été créé par une version plus récente de %1.").arg(qApp->applicationName()));
+			break;
+		case SlideshowReader::CorruptError:
+			QMessageBox::critical(this, qApp->applicationName(), tr("Le fichier demandé est endommagé et ne peut pas être ouvert."));
+			break;
+		default:
+			QMessageBox::critical(this, qApp->applicationName(), tr("Le fichier demandé ne peut pas être ouvert avec %1.").arg(qApp->applicationName()));
+			break;
 	}
-	file.close();
 
-	appendToRecentFiles(newFile);
+	this->setWindowModified(false);
+	newSlideshow();
+}
 
-	const QString fileName = QFileInfo(newFile).fileName();
-	this->setWindowTitle(fileName);
-	this->setWindowFilePath(newFile);
+void MainWindow::slideshowLoadFinished()
+{
+	if(sender() != loader)
+		return;
 
-	progress->close();
-	progress->deleteLater();
+	const QString filePath = this->windowFilePath();
+	const QString fileName = QFileInfo(loader->fileName()).fileName();
+	const int slidesCount = this->slideshow->getSlides().size();
+	abortLoading();
 
-	statusBar()->showMessage(tr("Fin du chargement de %1. Diapositives : %2 | Erreurs : %3").arg(fileName).arg(slidesCount).arg(errorsCount), STATUS_TIMEOUT);
-	if(slidesCount > 0)
+	if(!filePath.isEmpty())
+		appendToRecentFiles(filePath);
+	statusBar()->showMessage(tr("Fin du chargement de %1. Diapositives : %2 | Erreurs : %3").arg(fileName).arg(slidesCount).arg(loadErrors), STATUS_TIMEOUT);
+}
+
+void MainWindow::cancelLoading()
+{
+	if(loader == 0)
+		return;
+
+	// a partially loaded slideshow must never overwrite its file
+	abortLoading();
+	this->setWindowModified(false);
+	newSlideshow();
+
+	statusBar()->showMessage(tr("Chargement annulé."), STATUS_TIMEOUT);
+}
+
+void MainWindow::autosave()
+{
+	if(!journalOutdated || loader != 0 || journal->isRunning())
+		return;
+
+	// only references to the property maps are taken here, the encoding happens on the journal thread
+	const SlideshowSnapshot snapshot = this->slideshow->snapshot();
+
+	// only the edited slides are journaled, the others are referred to by their offset in the original file
+	SlideshowSnapshot journalSnapshot;
+	journalSnapshot.metadata = snapshot.metadata;
+	journalSnapshot.metadata[QStringLiteral("recoveryPath")] = this->windowFilePath();
+	journalSnapshot.metadata[QStringLiteral("recoverySource")] = snapshot.sourceFile;
+	journalSnapshot.metadata[QStringLiteral("recoveryIndexOffset")] = snapshot.sourceIndexOffset;
+	journalSnapshot.metadata[QStringLiteral("recoveryEmbedAssets")] = snapshot.metadata.value(QStringLiteral("embedAssets"));
+	journalSnapshot.metadata[QStringLiteral("embedAssets")] = false;
+
+	QVariantList sourceOffsets;
+	foreach(const SlideSnapshot &slide, snapshot.slides)
 	{
-		QListWidgetItem *item = ui->slideList->item(0);
-		ui->slideList->scrollToItem(item);
-		ui->slideList->setCurrentItem(item);
+		sourceOffsets << slide.chunk.offset;
+		if(slide.chunk.isNull())
+			journalSnapshot.slides << slide;
 	}
+	journalSnapshot.metadata[QStringLiteral("recoveryChunks")] = sourceOffsets;
 
-	return true;
+	journal->write(journalSnapshot);
+
+	journalOutdated = false;
+}
+
+void MainWindow::discardJournal()
+{
+	if(!journalLock->isLocked())
+		return;
+
+	journal->wait();
+	QFile::remove(JournalWriter::journalPath());
+	QFile::remove(JournalWriter::recoveredPath());
+}
+
+void MainWindow::journalFailed()
+{
+	// the next autosave tries again
+	journalOutdated = true;
+	statusBar()->showMessage(tr("Impossible d'écrire le fichier de récupération."), STATUS_TIMEOUT);
+}
+
+void MainWindow::finishLoading()
+{
+	if(loader == 0)
+		return;
+
+	loader->wait();
+	QCoreApplication::sendPostedEvents(this, QEvent::MetaCall);
+}
+
+void MainWindow::abortLoading()
+{
+	if(loader == 0)
+		return;
+
+	loader->requestInterruption();
+	loader->wait();
+	loader = 0;
+
+	loadProgress->hide();
+	loadCancelButton->hide();
+	ui->actionSaveAs->setEnabled(true);
+	ui->actionSave->setEnabled(this->isWindowModified());
 }
 
 bool MainWindow::saveSlideshow()
@@ -347,34 +555,43 @@ bool MainWindow::saveSlideshow()
 		return saveSlideshowAs();
 	}
 
-	QFile file(this->windowFilePath());
-	if(!file.open(QIODevice::WriteOnly))
+	// the slides still being parsed are part of the slideshow
+	finishLoading();
+	if(this->windowFilePath().isEmpty())
+		return false;
+
+	// unchanged slides are copied from the current file, stubs included
+	journal->wait();
+	slideshow->resolveAssetPaths();
+	SlideshowWriter writer(this->windowFilePath());
+	if(!writer.write(slideshow))
 	{
 		QMessageBox::critical(this, ui->actionSave->text(), tr("Impossible d'écrire dans le fichier."));
 		return false;
 	}
 
-	QDataStream out(&file);
+	SlideshowReader *reader = createReader(this->windowFilePath());
+	if(!reader->open() || !reader->readIndex())
+	{
+		delete reader;
+		reader = 0;
+	}
+	slideshow->setSource(reader);
 
-	QList<Slide *> slides = slideshow->getSlides();
-	out << qApp->applicationName();
-	out << slideshow->getValues();
-	out << slides.size();
-	foreach(Slide *slide, slides)
+	const QList<SlideChunk> chunks = writer.chunks();
+	const int slidesCount = chunks.size();
+	for(int index = 0; index < slidesCount; index++)
 	{
-		out << slide->getValues();
-		QList<SlideElement *> elements = slide->getElements();
-		out << elements.size();
-		foreach(SlideElement *element, elements)
-		{
-			out << element->type();
-			out << element->getValues();
-		}
+		Slide *slide = slideshow->getSlide(index);
+		slide->setChunk(reader != 0 ? chunks[index] : SlideChunk());
+		slide->setDirty(false);
 	}
-	file.close();
+
+	updateLoadedSlides(ui->slideList->currentRow());
+	discardJournal();
 
 	this->setWindowModified(false);
-	statusBar()->showMessage(tr("%1 diapositive(s) enregistrée(s) dans %2.").arg(slides.size()).arg(this->windowFilePath()), STATUS_TIMEOUT);
+	statusBar()->showMessage(tr("%1 diapositive(s) enregistrée(s) dans %2.").arg(slideshow->getSlides().size()).arg(this->windowFilePath()), STATUS_TIMEOUT);
 	return true;
 }
 
@@ -406,26 +623,25 @@ bool MainWindow::closeSlideshow()
 		}
 	}
 
+	abortLoading();
+	thumbnails->cancelAll();
+	pendingRenders.clear();
+	pendingIcons.clear();
 	statusBar()->showMessage(tr("Fermeture du diaporama..."));
 
 	QMainWindow::setWindowTitle(QString("[*]%1").arg(qApp->applicationName()));
 	this->setWindowModified(false);
+	foreach(Slide *slide, slideScenes.keys())
+		releaseScene(slide);
+	residency->clear();
 	delete this->slideshow;
+	discardJournal();
 
 	ui->slideList->clear();
 	ui->slideTree->clear();
 	ui->propertiesEditor->clear();
 	updateMediaPreview();
 
-	while(ui->displayWidget->count() > 0)
-	{
-		GraphicsView *view = qobject_cast<GraphicsView *>(ui->displayWidget->widget(0));
-		view->scene()->blockSignals(true);
-		delete view->scene();
-		ui->displayWidget->removeWidget(view);
-		delete view;
-	}
-
 	statusBar()->clearMessage();
 
 	this->setWindowFilePath(QString());
@@ -443,6 +659,46 @@ void MainWindow::closeEvent(QCloseEvent *event)
 	QMainWindow::closeEvent(event);
 }
 
+SlideshowReader *MainWindow::createReader(const QString &fileName)
+{
+	SlideshowReader *reader = new SlideshowReader(fileName);
+	reader->setElementTypes(registeredTypes.keys());
+	connect(reader, &SlideshowReader::unknownElement, this, &MainWindow::unknownElementFound);
+	connect(reader, &SlideshowReader::corruptSlide, this, &MainWindow::corruptSlideFound);
+
+	return reader;
+}
+
+void MainWindow::unknownElementFound(const QString &slideName, const QString &type, const int index)
+{
+	if(qobject_cast<SlideshowLoader *>(sender()) != 0 && sender() != loader)
+		return;
+
+	if(loadErrors == 0)
+	{
+		QMessageBox::warning(this, qApp->applicationName(),
+			tr("La diapositive %1 contient un élément graphique inconnu (%2@%3). L'élément a été ignoré. Il reste dans le fichier tant que la diapositive n'est pas modifiée.\n\nLes erreurs suivantes ne seront pas rapportés.")
+				.arg(slideName)
+				.arg(type.isEmpty() ? tr("Inconnu") : type)
+				.arg(index)
+		);
+		this->setWindowModified(true);
+	}
+
+	loadErrors++;
+}
+
+void MainWindow::corruptSlideFound(const QString &slideName)
+{
+	if(qobject_cast<SlideshowLoader *>(sender()) != 0 && sender() != loader)
+		return;
+
+	// slides are decoded when first shown: the error is reported whenever it shows up
+	statusBar()->showMessage(tr("La diapositive %1 est endommagée, seule une partie de son contenu a pu être lue.").arg(slideName), STATUS_TIMEOUT);
+	this->setWindowModified(true);
+	loadErrors++;
+}
+
 void MainWindow::createEmptySlide()
 {
 	Slide *slide = slideshow->createSlide();
@@ -464,36 +720,18 @@ void MainWindow::displaySlide(Slide *slide)
 {
 	statusBar()->showMessage(tr("Affichage de %1...").arg(slide->getValue(QStringLiteral("name")).toString()));
 
-	QGraphicsScene *scene = new QGraphicsScene;
-	scene->setSceneRect(QRect(QPoint(), slideshow->getValue(QStringLiteral("size")).toSize()));
-	scene->setItemIndexMethod(QGraphicsScene::NoIndex);
-
-	connect(scene, &QGraphicsScene::selectionChanged, this, &MainWindow::updateCurrentSlideTree);
-	connect(scene, &QGraphicsScene::selectionChanged, this, &MainWindow::updateSelectionActions);
-	connect(scene, &QGraphicsScene::selectionChanged, this, &MainWindow::updateCurrentPropertiesEditor);
-	connect(scene, &QGraphicsScene::selectionChanged, this, &MainWindow::updateMediaPreview);
-
-	GraphicsView *view = new GraphicsView(scene);
-	view->setContextMenuPolicy(Qt::CustomContextMenu);
-	connect(view, &QWidget::customContextMenuRequested, this, &MainWindow::displayViewContextMenu);
-	ui->displayWidget->addWidget(view);
-
-	QPixmap pixmap(scene->sceneRect().size().toSize());
-	QPainter painter(&pixmap);
-	slide->render(scene, true);
-	scene->render(&painter, scene->sceneRect());
-
-	const int slideIndex = ui->slideList->count();
 	const int currentRow = ui->slideList->currentRow();
-	const int keepStart = currentRow - (MAX_LOADED_SLIDES / 2);
-	const int keepEnd = currentRow + (MAX_LOADED_SLIDES / 2);
-	if(slideIndex < keepStart || slideIndex > keepEnd)
-		scene->clear();
+	const int iconWidth = ui->slideList->iconSize().width();
+
+	// the real icon is rendered in the background, stub slides get it once they enter the loaded window
+	QPixmap placeholder(ThumbnailRenderer::thumbnailSize(slideshow->getValue(QStringLiteral("size")).toSize(), iconWidth));
+	placeholder.fill(Qt::lightGray);
 
-	QIcon icon(pixmap.scaledToWidth(ui->slideList->iconSize().width()));
-	QListWidgetItem *newItem = new QListWidgetItem(icon, slide->getValue(QStringLiteral("name")).toString());
+	QListWidgetItem *newItem = new QListWidgetItem(slide->getValue(QStringLiteral("name")).toString());
 	newItem->setFlags(newItem->flags() ^ Qt::ItemIsEditable);
+	newItem->setIcon(QIcon(placeholder));
 	ui->slideList->addItem(newItem);
+	newItem->setData(Qt::UserRole, requestIcon(slide));
 
 	if(currentRow == -1)
 		ui->slideList->setCurrentRow(0);
@@ -501,6 +739,7 @@ void MainWindow::displaySlide(Slide *slide)
 	this->slideActions->setEnabled(true);
 
 	connect(slide, &SlideshowElement::modified, this, &MainWindow::slideModified);
+	connect(slide, &Slide::elementModified, this, &MainWindow::elementModified);
 	connect(slide, &Slide::moved, this, &MainWindow::slideElementMoved);
 	connect(slide, &Slide::refresh, this, &MainWindow::refreshSlide);
 	connect(slide, &Slide::updateProperties, this, &MainWindow::updateCurrentPropertiesEditor);
@@ -519,28 +758,32 @@ void MainWindow::renderSlide(const int index)
 
 	Slide *slide = this->slideshow->getSlide(index);
 
-	const GraphicsView *view = qobject_cast<GraphicsView *>(ui->displayWidget->widget(index));
-	view->scene()->blockSignals(true);
-	view->scene()->clear();
-	view->scene()->blockSignals(false);
-	slide->render(view->scene(), true);
+	// slides outside of the loaded window have no scene, only their icon is refreshed
+	QGraphicsScene *scene = slideScenes.value(slide);
+	if(scene != 0)
+	{
+		scene->blockSignals(true);
+		scene->clear();
+		scene->blockSignals(false);
+		slide->render(scene, true);
+		residency->setCost(slide, SlideResidency::sceneCost(scene));
+	}
 
 	ui->slideList->blockSignals(true);
 	ui->slideList->item(index)->setText(slide->getValue(QStringLiteral("name")).toString());
 	ui->slideList->blockSignals(false);
 
-	updateSlideIcon(index);
+	scheduleIconUpdate(index);
 
-	if(index == ui->slideList->currentRow())
+	if(index == ui->slideList->currentRow() && scene != 0)
 	{
-		const GraphicsView *view = qobject_cast<GraphicsView *>(ui->displayWidget->widget(index));
-		view->scene()->blockSignals(true);
+		scene->blockSignals(true);
 		foreach(const int index, selectedElements)
 		{
 			QGraphicsItem *graphicsItem = sceneItemFromIndex(index);
 			if(graphicsItem != 0) graphicsItem->setSelected(true);
 		}
-		view->scene()->blockSignals(false);
+		scene->blockSignals(false);
 		updateSlideTree(index);
 	}
 
@@ -548,16 +791,89 @@ void MainWindow::renderSlide(const int index)
 
 void MainWindow::updateSlideIcon(const int index)
 {
-	const GraphicsView *view = qobject_cast<GraphicsView *>(ui->displayWidget->widget(index));
+	if(!requestIcon(this->slideshow->getSlide(index)))
+		return;
+
+	// the previous icon stays visible until the new one is ready
+	ui->slideList->blockSignals(true);
+	ui->slideList->item(index)->setData(Qt::UserRole, true);
+	ui->slideList->blockSignals(false);
+}
 
-	QPixmap pixmap(view->scene()->sceneRect().size().toSize());
-	QPainter painter(&pixmap);
-	view->scene()->render(&painter, view->scene()->sceneRect());
+bool MainWindow::requestIcon(Slide *slide)
+{
+	const int iconWidth = ui->slideList->iconSize().width();
 
-	const QIcon icon(pixmap.scaledToWidth(ui->slideList->iconSize().width()));
+	QGraphicsScene *scene = slideScenes.value(slide);
+	if(scene != 0)
+	{
+		thumbnails->request(slide, scene, iconWidth);
+		return true;
+	}
+
+	if(!slide->isLoaded())
+	{
+		thumbnails->requestCached(slide, iconWidth);
+		return false;
+	}
+
+	// the picture is recorded right away, so one scratch scene serves every slide without a scene
+	offscreenScene->setSceneRect(QRect(QPoint(), slideshow->getValue(QStringLiteral("size")).toSize()));
+	slide->render(offscreenScene, false);
+	thumbnails->request(slide, offscreenScene, iconWidth);
+	offscreenScene->clear();
+	return true;
+}
+
+QGraphicsScene *MainWindow::acquireScene(Slide *slide)
+{
+	QGraphicsScene *scene = slideScenes.value(slide);
+	if(scene != 0)
+		return scene;
+
+	if(!freeScenes.isEmpty())
+		scene = freeScenes.takeLast();
+	else
+	{
+		scene = new QGraphicsScene(this);
+		scene->setItemIndexMethod(QGraphicsScene::NoIndex);
+
+		connect(scene, &QGraphicsScene::selectionChanged, this, &MainWindow::updateCurrentSlideTree);
+		connect(scene, &QGraphicsScene::selectionChanged, this, &MainWindow::updateSelectionActions);
+		connect(scene, &QGraphicsScene::selectionChanged, this, &MainWindow::updateCurrentPropertiesEditor);
+		connect(scene, &QGraphicsScene::selectionChanged, this, &MainWindow::updateMediaPreview);
+	}
+
+	scene->setSceneRect(QRect(QPoint(), slideshow->getValue(QStringLiteral("size")).toSize()));
+	slide->render(scene, true);
+	slideScenes.insert(slide, scene);
+	return scene;
+}
+
+void MainWindow::releaseScene(Slide *slide)
+{
+	QGraphicsScene *scene = slideScenes.take(slide);
+	if(scene == 0)
+		return;
+
+	if(editorView->scene() == scene)
+		editorView->setScene(0);
+
+	scene->blockSignals(true);
+	scene->clear();
+	scene->blockSignals(false);
+	freeScenes << scene;
+}
+
+void MainWindow::thumbnailReady(Slide *slide, const QImage &image)
+{
+	const int index = this->slideshow != 0 ? this->slideshow->indexOf(slide) : -1;
+	if(index < 0 || index >= ui->slideList->count())
+		return;
 
 	ui->slideList->blockSignals(true);
-	ui->slideList->item(index)->setIcon(icon);
+	ui->slideList->item(index)->setIcon(QIcon(QPixmap::fromImage(image)));
+	ui->slideList->item(index)->setData(Qt::UserRole, true);
 	ui->slideList->blockSignals(false);
 }
 
@@ -581,7 +897,7 @@ void MainWindow::updateSlideTree(const int index)
 	{
 		SlideElement *element = iterator.previous();
 
-		const int elementIndex = elements.indexOf(element);
+		const int elementIndex = element->getIndex();
 		QTreeWidgetItem *treeItem = new QTreeWidgetItem(topLevel);
 		treeItem->setIcon(0, registeredTypes.value(QMetaType::type(element->type())).getIcon());
 		treeItem->setText(0, element->getValue(QStringLiteral("name")).toString());
@@ -670,7 +986,7 @@ void MainWindow::updateMediaPreview()
 
 	if(!previewUrl.isEmpty())
 	{
-		previewPlayer->setMedia(QUrl::fromLocalFile(previewUrl));
+		previewPlayer->setMedia(this->slideshow->mediaUrl(previewUrl));
 		previewPlayer->play();
 		ui->mediaPreview->setEnabled(true);
 	}
@@ -713,15 +1029,16 @@ bool MainWindow::validateElementName(const QString &name)
 
 QGraphicsItem *MainWindow::sceneItemFromIndex(const int index) const
 {
-	const GraphicsView *view = qobject_cast<GraphicsView *>(ui->displayWidget->currentWidget());
-	foreach(QGraphicsItem *item, view->scene()->items())
-	{
-		bool valid;
-		if(item->data(Qt::UserRole).toInt(&valid) == index && valid)
-			return item;
-	}
+	// elements keep their editor item, whose data holds the element index in return
+	const int currentRow = ui->slideList->currentRow();
+	if(currentRow < 0)
+		return 0;
 
-	return 0;
+	const Slide *slide = this->slideshow->getSlide(currentRow);
+	if(!slide->isLoaded() || index < 0 || index >= slide->getElements().size())
+		return 0;
+
+	return slide->getElement(index)->graphicsItem();
 }
 
 void MainWindow::refreshSlide()
@@ -730,7 +1047,71 @@ void MainWindow::refreshSlide()
 	Slide *senderSlide = qobject_cast<Slide *>(sender());
 	if(senderSlide != 0) index = this->slideshow->indexOf(senderSlide);
 
-	renderSlide(index);
+	scheduleRender(index);
+}
+
+void MainWindow::scheduleRender(const int index)
+{
+	if(index < 0)
+		return;
+
+	pendingRenders.insert(this->slideshow->getSlide(index));
+	if(!renderTimer.isActive())
+		renderTimer.start();
+}
+
+void MainWindow::scheduleIconUpdate(const int index)
+{
+	pendingIcons.insert(this->slideshow->getSlide(index));
+	iconTimer.start();
+}
+
+void MainWindow::flushRenders()
+{
+	// large batches are spread over several frames to keep the window responsive
+	int rendered = 0;
+	while(!pendingRenders.isEmpty() && rendered < RENDER_BATCH_SIZE)
+	{
+		Slide *slide = *pendingRenders.begin();
+		pendingRenders.remove(slide);
+
+		const int index = this->slideshow->indexOf(slide);
+		if(index < 0)
+			continue;
+
+		if(!slideScenes.contains(slide) && !slide->isLoaded())
+		{
+			// slides outside of the loaded window are rendered when they enter it
+			QPixmap placeholder(ThumbnailRenderer::thumbnailSize(slideshow->getValue(QStringLiteral("size")).toSize(), ui->slideList->iconSize().width()));
+			placeholder.fill(Qt::lightGray);
+
+			ui->slideList->blockSignals(true);
+			ui->slideList->item(index)->setIcon(QIcon(placeholder));
+			ui->slideList->item(index)->setData(Qt::UserRole, false);
+			ui->slideList->blockSignals(false);
+
+			thumbnails->requestCached(slide, ui->slideList->iconSize().width());
+			continue;
+		}
+
+		renderSlide(index);
+		rendered++;
+	}
+
+	if(!pendingRenders.isEmpty())
+		renderTimer.start();
+}
+
+void MainWindow::flushIconUpdates()
+{
+	foreach(Slide *slide, pendingIcons)
+	{
+		const int index = this->slideshow->indexOf(slide);
+		if(index >= 0)
+			updateSlideIcon(index);
+	}
+
+	pendingIcons.clear();
 }
 
 void MainWindow::deleteSlide()
@@ -742,17 +1123,17 @@ void MainWindow::deleteSlide()
 	const int index = ui->slideList->currentRow();
 	ui->slideTree->clear();
 	ui->propertiesEditor->clear();
+	thumbnails->cancel(this->slideshow->getSlide(index));
+	pendingRenders.remove(this->slideshow->getSlide(index));
+	pendingIcons.remove(this->slideshow->getSlide(index));
+	releaseScene(this->slideshow->getSlide(index));
+	residency->remove(this->slideshow->getSlide(index));
 	this->slideshow->removeSlide(index);
 
 	ui->slideList->blockSignals(true);
 	delete ui->slideList->takeItem(index);
 	ui->slideList->blockSignals(false);
 
-	GraphicsView *view = qobject_cast<GraphicsView *>(ui->displayWidget->currentWidget());
-	ui->displayWidget->removeWidget(view);
-	delete view->scene();
-	delete view;
-
 	if(this->slideshow->getSlides().size() > 0)
 		currentSlideChanged(ui->slideList->currentRow());
 	else
@@ -771,6 +1152,40 @@ void MainWindow::slideModified()
 	setWindowModified(true);
 }
 
+void MainWindow::elementModified(SlideElement *element)
+{
+	setWindowModified(true);
+
+	Slide *slide = element->slide();
+	const int index = this->slideshow->indexOf(slide);
+	if(index < 0)
+		return;
+
+	scheduleIconUpdate(index);
+
+	// slides which are not displayed are rendered from scratch when they are needed
+	QGraphicsScene *scene = slideScenes.value(slide);
+	if(scene == 0)
+		return;
+
+	scene->blockSignals(true);
+	slide->updateElement(element, scene);
+	scene->blockSignals(false);
+	residency->setCost(slide, SlideResidency::sceneCost(scene));
+
+	if(index == ui->slideList->currentRow() && ui->slideTree->topLevelItemCount() > 0)
+	{
+		QTreeWidgetItem *topLevel = ui->slideTree->topLevelItem(0);
+		QTreeWidgetItem *treeItem = topLevel->child(topLevel->childCount() - 1 - element->getIndex());
+		if(treeItem != 0)
+		{
+			ui->slideTree->blockSignals(true);
+			treeItem->setText(0, element->getValue(QStringLiteral("name")).toString());
+			ui->slideTree->blockSignals(false);
+		}
+	}
+}
+
 void MainWindow::slideElementMoved()
 {
 	moveFinishTimer.start();
@@ -804,8 +1219,10 @@ void MainWindow::currentSlideChanged(int currentRow)
 	if(currentRow == -1)
 		return;
 
+	updateLoadedSlides(currentRow);
+
 	const int slideCount = this->slideshow->getSlides().size();
-	ui->displayWidget->setCurrentIndex(currentRow);
+	editorView->setScene(slideScenes.value(this->slideshow->getSlide(currentRow)));
 	ui->actionMoveSlideLeft->setEnabled(slideCount > 0 && currentRow != 0);
 	ui->actionMoveSlideRight->setEnabled(slideCount > 0 && currentRow != slideCount - 1);
 
@@ -813,20 +1230,31 @@ void MainWindow::currentSlideChanged(int currentRow)
 	updateCurrentPropertiesEditor();
 	updateMediaPreview();
 	updateSelectionActions();
+}
 
-	const int keepStart = currentRow - (MAX_LOADED_SLIDES / 2);
-	const int keepEnd = currentRow + (MAX_LOADED_SLIDES / 2);
-	for(int index = 0; index < slideCount; index++)
-	{
-		const GraphicsView *view = qobject_cast<GraphicsView *>(ui->displayWidget->widget(index));
-		if(index < keepStart || index > keepEnd)
-			view->scene()->clear();
-		else if(view->scene()->items().size() == 0)
-		{
-			Slide *slide = this->slideshow->getSlide(index);
-			slide->render(view->scene(), true);
-		}
-	}
+void MainWindow::updateLoadedSlides(const int currentRow)
+{
+	// the viewer decodes and unloads the slides it shows on its own
+	if(viewer != 0)
+		return;
+
+	residency->update(this->slideshow->getSlides(), currentRow);
+}
+
+void MainWindow::populateSlide(Slide *slide)
+{
+	QGraphicsScene *scene = acquireScene(slide);
+	residency->setCost(slide, SlideResidency::sceneCost(scene));
+
+	const int index = this->slideshow->indexOf(slide);
+	if(!ui->slideList->item(index)->data(Qt::UserRole).toBool())
+		updateSlideIcon(index);
+}
+
+void MainWindow::evictSlide(Slide *slide)
+{
+	releaseScene(slide);
+	slide->unload();
 }
 
 void MainWindow::slideItemChanged(QListWidgetItem *item)
@@ -875,10 +1303,10 @@ void MainWindow::elementItemChanged(QTreeWidgetItem *item, int)
 
 void MainWindow::elementSelectionChanged()
 {
-	GraphicsView *view = qobject_cast<GraphicsView *>(ui->displayWidget->currentWidget());
-	view->setFocus();
-	view->scene()->blockSignals(true);
-	view->scene()->clearSelection();
+	QGraphicsScene *scene = editorView->scene();
+	editorView->setFocus();
+	scene->blockSignals(true);
+	scene->clearSelection();
 	foreach(const QTreeWidgetItem *item, ui->slideTree->selectedItems())
 	{
 		const int index = item->data(0, Qt::UserRole).toInt();
@@ -886,7 +1314,7 @@ void MainWindow::elementSelectionChanged()
 		if(graphicsItem != 0)
 			graphicsItem->setSelected(true);
 	}
-	view->scene()->blockSignals(false);
+	scene->blockSignals(false);
 
 	updateCurrentPropertiesEditor();
 	updateMediaPreview();
@@ -924,12 +1352,12 @@ void MainWindow::moveElement(const int before, const int after)
 
 	renderSlide(index);
 
-	const GraphicsView *view = qobject_cast<GraphicsView *>(ui->displayWidget->currentWidget());
-	view->scene()->clearSelection();
+	QGraphicsScene *scene = editorView->scene();
+	scene->clearSelection();
 
 	QGraphicsItem *graphicsItem = sceneItemFromIndex(after);
 	if(graphicsItem != 0) graphicsItem->setSelected(true);
-	view->scene()->blockSignals(false);
+	scene->blockSignals(false);
 
 	updateSlideTree(index);
 	updateSelectionActions();
@@ -1004,7 +1432,10 @@ void MainWindow::launchViewer(const int from)
 		return;
 	}
 
-	ViewWidget *viewer = new ViewWidget;
+	// the viewer renders every slide of the slideshow, which must not change under it
+	finishLoading();
+
+	viewer = new ViewWidget;
 	connect(viewer, &ViewWidget::closed, this, &MainWindow::viewerClosed);
 	viewer->setSlideshow(this->slideshow, from);
 	viewer->showFullScreen();
@@ -1018,6 +1449,7 @@ void MainWindow::viewerClosed()
 	this->show();
 	elementSelectionChanged();
 	sender()->deleteLater();
+	viewer = 0;
 
 	statusBar()->showMessage(tr("Temps de lecture : %1").arg(msToString(viewerTimer.elapsed())));
 }
@@ -1074,7 +1506,7 @@ void MainWindow::print()
 	if(dialog->exec() != QDialog::Accepted)
 		return statusBar()->clearMessage();
 
-	const int slidesCount = ui->displayWidget->count();
+	const int slidesCount = slideshow->getSlides().size();
 	int fromPage = printer.fromPage() > 0 ? printer.fromPage() - 1 : 0;
 	int toPage = printer.toPage() > 0 ? printer.toPage() : slidesCount;
 
@@ -1098,9 +1530,24 @@ void MainWindow::print()
 
 		painter.drawText(QRectF(0, 10, printer.pageRect().width(), 15), Qt::AlignCenter, ui->slideList->item(page)->text());
 
-		const GraphicsView *view = qobject_cast<GraphicsView *>(ui->displayWidget->widget(page));
-		view->scene()->clearSelection();
-		view->scene()->render(&painter, pageRect);
+		Slide *slide = slideshow->getSlide(page);
+		QGraphicsScene *scene = slideScenes.value(slide);
+		if(scene != 0)
+		{
+			scene->clearSelection();
+			scene->render(&painter, pageRect);
+		}
+		else
+		{
+			// slides outside of the loaded window are drawn in the scratch scene and unloaded again
+			const bool wasLoaded = slide->isLoaded();
+			offscreenScene->setSceneRect(QRect(QPoint(), slideshow->getValue(QStringLiteral("size")).toSize()));
+			slide->render(offscreenScene, false);
+			offscreenScene->render(&painter, pageRect);
+			offscreenScene->clear();
+			if(!wasLoaded)
+				slide->unload();
+		}
 
 		if(page < slidesCount - 1)
 			printer.newPage();
@@ -1276,38 +1723,75 @@ void MainWindow::populateInsertMenu()
 	ui->menuInsert->addActions(insertActions);
 }
 
+void MainWindow::setEmbedMedia(const bool embed)
+{
+	if(this->slideshow->getValue(QStringLiteral("embedAssets")).toBool() == embed)
+		return;
+
+	this->slideshow->setValue(QStringLiteral("embedAssets"), embed);
+	setWindowModified(true);
+}
+
+void MainWindow::setAutoAdvance(const bool autoAdvance)
+{
+	if(this->slideshow->getValue(QStringLiteral("autoAdvance")).toBool() == autoAdvance)
+		return;
+
+	this->slideshow->setValue(QStringLiteral("autoAdvance"), autoAdvance);
+	setWindowModified(true);
+}
+
+void MainWindow::setLoop(const bool loop)
+{
+	if(this->slideshow->getValue(QStringLiteral("loop")).toBool() == loop)
+		return;
+
+	this->slideshow->setValue(QStringLiteral("loop"), loop);
+	setWindowModified(true);
+}
+
+void MainWindow::setMemoryBudget()
+{
+	bool ok;
+	const int budget = QInputDialog::getInt(this, ui->actionMemoryBudget->text(), tr("Mémoire maximale occupée par les diapositives chargées (Mio) :"), QSettings().value(QStringLiteral("memoryBudget"), MEMORY_BUDGET).toInt(), 16, 65536, 16, &ok);
+	if(!ok)
+		return;
+
+	QSettings().setValue(QStringLiteral("memoryBudget"), budget);
+	residency->setBudget(qint64(budget) << 20);
+
+	if(ui->slideList->currentRow() != -1)
+		updateLoadedSlides(ui->slideList->currentRow());
+}
+
+void MainWindow::setCompressSlides(const bool compress)
+{
+	const int codec = compress ? SlideChunk::ZlibCodec : SlideChunk::NoCodec;
+	if(this->slideshow->getValue(QStringLiteral("compression")).toInt() == codec)
+		return;
+
+	this->slideshow->setValue(QStringLiteral("compression"), codec);
+	setWindowModified(true);
+}
+
 void MainWindow::resizeSlideshow()
 {
 	ResizeDialog *dialog = new ResizeDialog(slideshow->getValue(QStringLiteral("size")).toSize(), this);
 	if(dialog->exec() == QDialog::Rejected)
 		return;
 
-	const int slideCount = ui->displayWidget->count();
+	const int slideCount = slideshow->getSlides().size();
 	const QSize newSize = dialog->getSize();
 	const QRect newRect = QRect(QPoint(), newSize);
 	slideshow->setValue(QStringLiteral("size"), newSize);
 
-	QProgressDialog *progress = new QProgressDialog(this);
-	progress->setWindowTitle(ui->actionResizeSlideshow->text());
-	progress->setWindowFlags(Qt::Dialog | Qt::CustomizeWindowHint | Qt::WindowTitleHint);
-	progress->setCancelButtonText(QString());
-	progress->setLabelText(tr("Mise à jour de toutes les diapositives en cours..."));
-	progress->setMaximum(slideCount);
-	progress->open();
+	foreach(QGraphicsScene *scene, slideScenes)
+		scene->setSceneRect(newRect);
 
 	for(int index = 0; index < slideCount; index++)
-	{
-		progress->setValue(index + 1);
-
-		const GraphicsView *view = qobject_cast<GraphicsView *>(ui->displayWidget->widget(index));
-		view->scene()->setSceneRect(newRect);
-		renderSlide(index);
-	}
+		scheduleRender(index);
 
 	setWindowModified(true);
-
-	progress->close();
-	progress->deleteLater();
 	dialog->deleteLater();
 }
 
@@ -1471,7 +1955,7 @@ void MainWindow::appendToRecentFiles(const QString &openedFile)
 void MainWindow::alignElementsTo(const AlignDirection direction)
 {
 	const int slideIndex = ui->slideList->currentRow();
-	const GraphicsView *view = qobject_cast<GraphicsView *>(ui->displayWidget->widget(slideIndex));
+	const QGraphicsScene *scene = editorView->scene();
 	const Slide *slide = slideshow->getSlide(slideIndex);
 
 	foreach(const QTreeWidgetItem *item, ui->slideTree->selectedItems())
@@ -1491,19 +1975,19 @@ void MainWindow::alignElementsTo(const AlignDirection direction)
 				pos.setX(0);
 				break;
 			case ALIGN_HCENTER:
-				pos.setX((view->scene()->sceneRect().width() / 2) - (graphicsItem->boundingRect().width() / 2));
+				pos.setX((scene->sceneRect().width() / 2) - (graphicsItem->boundingRect().width() / 2));
 				break;
 			case ALIGN_RIGHT:
-				pos.setX(view->scene()->sceneRect().width() - graphicsItem->boundingRect().width());
+				pos.setX(scene->sceneRect().width() - graphicsItem->boundingRect().width());
 				break;
 			case ALIGN_TOP:
 				pos.setY(0);
 				break;
 			case ALIGN_VCENTER:
-				pos.setY((view->scene()->sceneRect().height() / 2) - (graphicsItem->boundingRect().height() / 2));
+				pos.setY((scene->sceneRect().height() / 2) - (graphicsItem->boundingRect().height() / 2));
 				break;
 			case ALIGN_BOTTOM:
-				pos.setY(view->scene()->sceneRect().height() - graphicsItem->boundingRect().height());
+				pos.setY(scene->sceneRect().height() - graphicsItem->boundingRect().height());
 				break;
 		}
 		element->setValue(key, pos);
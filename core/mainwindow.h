@@ -22,6 +22,7 @@
 #include <QMainWindow>
 #include <QTimer>
 #include <QElapsedTimer>
+#include <QSet>
 #include <QMediaPlayer>
 
 #include "slideelementtype.h"
@@ -31,6 +32,11 @@ class QTreeWidgetItem;
 class QListWidgetItem;
 class QPluginLoader;
 class QActionGroup;
+class QProgressBar;
+class QToolButton;
+class QLockFile;
+class QImage;
+class QGraphicsScene;
 
 namespace Ui
 {
@@ -41,6 +47,13 @@ class Slideshow;
 class SlideshowElement;
 class Slide;
 class SlideElement;
+class SlideshowReader;
+class SlideshowLoader;
+class JournalWriter;
+class ThumbnailRenderer;
+class GraphicsView;
+class SlideResidency;
+class ViewWidget;
 
 class MainWindow : public QMainWindow
 {
@@ -78,6 +91,8 @@ public slots:
 	bool saveSlideshow();
 	bool saveSlideshowAs();
 	bool openSlideshow(const QString &knowPath = QString());
+	void cancelLoading();
+	void autosave();
 	void updateCurrentSlideTree();
 	void updateCurrentPropertiesEditor();
 	void updateSelectionActions();
@@ -86,6 +101,7 @@ public slots:
 	void refreshSlide();
 	void deleteSlide();
 	void slideModified();
+	void elementModified(SlideElement *element);
 	void slideElementMoved();
 	void launchViewerFromCurrentSlide();
 	void launchViewerFromStart();
@@ -104,6 +120,11 @@ public slots:
 	void openRecentFile(QAction *);
 	void populateInsertMenu();
 	void resizeSlideshow();
+	void setEmbedMedia(const bool embed);
+	void setCompressSlides(const bool compress);
+	void setMemoryBudget();
+	void setAutoAdvance(const bool autoAdvance);
+	void setLoop(const bool loop);
 	void currentSlideChanged(int currentRow);
 	void slideItemChanged(QListWidgetItem *item);
 	void elementItemChanged(QTreeWidgetItem *item, int column);
@@ -146,11 +167,25 @@ private:
 	void launchViewer(const int from);
 	void appendToRecentFiles(const QString &openedFile);
 	void clearClipboard();
+	SlideshowReader *createReader(const QString &fileName);
+	void updateLoadedSlides(const int currentRow);
+	void scheduleRender(const int index);
+	void scheduleIconUpdate(const int index);
+	QGraphicsScene *acquireScene(Slide *slide);
+	void releaseScene(Slide *slide);
+	bool requestIcon(Slide *slide);
+	void finishLoading();
+	void abortLoading();
+	void discardJournal();
 
 	Ui::MainWindow *ui;
 	Slideshow *slideshow;
 	int newSlideshowCount;
 	QTimer moveFinishTimer;
+	QTimer renderTimer;
+	QTimer iconTimer;
+	QSet<Slide *> pendingRenders;
+	QSet<Slide *> pendingIcons;
 	QList<QAction *> insertActions;
 	QList<QPluginLoader *> plugins;
 	QString commandLineHelp;
@@ -161,6 +196,21 @@ private:
 	QMediaPlayer *previewPlayer;
 	QElapsedTimer viewerTimer;
 	QList<SlideElement *> clipboard;
+	int loadErrors;
+	SlideshowLoader *loader;
+	ViewWidget *viewer;
+	QProgressBar *loadProgress;
+	QToolButton *loadCancelButton;
+	JournalWriter *journal;
+	QLockFile *journalLock;
+	QTimer autosaveTimer;
+	bool journalOutdated;
+	ThumbnailRenderer *thumbnails;
+	GraphicsView *editorView;
+	QHash<Slide *, QGraphicsScene *> slideScenes;
+	QList<QGraphicsScene *> freeScenes;
+	QGraphicsScene *offscreenScene;
+	SlideResidency *residency;
 
 private slots:
 	void displayViewContextMenu(const QPoint &);
@@ -168,6 +218,18 @@ private slots:
 	void displaySlideListContextMenu(const QPoint &pos);
 	void insertElementFromAction();
 	void viewerClosed();
+	void unknownElementFound(const QString &slideName, const QString &type, const int index);
+	void corruptSlideFound(const QString &slideName);
+	void journalFailed();
+	void slideshowIndexLoaded(const QVariantMap &metadata, const int slidesCount);
+	void slidesLoaded(const QList<Slide *> &slides);
+	void slideshowLoadFailed(const int error);
+	void slideshowLoadFinished();
+	void thumbnailReady(Slide *slide, const QImage &image);
+	void flushRenders();
+	void flushIconUpdates();
+	void populateSlide(Slide *slide);
+	void evictSlide(Slide *slide);
 
 protected:
 	virtual void closeEvent(QCloseEvent *);
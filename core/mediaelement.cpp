@@ -0,0 +1,167 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QMediaPlaylist>
+
+#include "mediaelement.h"
+#include "slideshow.h"
+
+MediaElement::MediaElement() : SlideElement()
+{
+	player = 0;
+	playbackFinished = false;
+	setValue(QStringLiteral("volume"), 100);
+}
+
+MediaElement::MediaElement(const MediaElement &copy) : SlideElement(copy)
+{
+	// a copy borrows its own player
+	player = 0;
+	playbackFinished = false;
+}
+
+MediaElement::~MediaElement()
+{
+	releasePlayer();
+}
+
+QString MediaElement::previewUrl() const
+{
+	return getValue(QStringLiteral("src")).toString();
+}
+
+QStringList MediaElement::assets() const
+{
+	const QString src = getValue(QStringLiteral("src")).toString();
+	return src.isEmpty() ? QStringList() : QStringList(src);
+}
+
+void MediaElement::stateChanged(QMediaPlayer::State state)
+{
+	if(state != QMediaPlayer::StoppedState)
+		return;
+
+	// also sent when the media cannot be played: an unattended slideshow must not wait for it
+	playbackFinished = true;
+	emit finished();
+}
+
+bool MediaElement::isPlaying() const
+{
+	// looping media never end, they do not hold the slide
+	return player != 0 && !playbackFinished && !getValue(QStringLiteral("loop")).toBool();
+}
+
+void MediaElement::setPlayerPool(MediaPlayerPool *pool)
+{
+	this->pool = pool;
+}
+
+bool MediaElement::hasOutput() const
+{
+	return true;
+}
+
+void MediaElement::setOutput(QMediaPlayer *)
+{
+}
+
+bool MediaElement::attachPlayer()
+{
+	if(player != 0)
+		return true;
+
+	// only the viewer lends players, and no more than its pool holds
+	if(pool == 0 || !hasOutput())
+		return false;
+
+	player = pool->acquire();
+	if(player == 0)
+		return false;
+
+	setOutput(player);
+	player->setVolume(getValue(QStringLiteral("volume")).toInt());
+	connect(player, &QMediaPlayer::stateChanged, this, &MediaElement::stateChanged);
+
+	QMediaPlaylist *playlist = new QMediaPlaylist(player);
+	playlist->addMedia(slideshow()->mediaUrl(getValue(QStringLiteral("src")).toString()));
+	if(getValue(QStringLiteral("loop")).toBool())
+		playlist->setPlaybackMode(QMediaPlaylist::CurrentItemInLoop);
+	player->setPlaylist(playlist);
+
+	return true;
+}
+
+void MediaElement::prepare()
+{
+	// pausing a stopped player opens and buffers the media without starting it
+	if(!playbackFinished && attachPlayer() && player->state() == QMediaPlayer::StoppedState)
+		player->pause();
+}
+
+void MediaElement::play()
+{
+	// a media which ended or failed while its slide was prepared is reported again once the slide is shown
+	if(playbackFinished)
+		QMetaObject::invokeMethod(this, "finished", Qt::QueuedConnection);
+	else if(attachPlayer())
+		player->play();
+}
+
+void MediaElement::pause()
+{
+	if(player != 0 && !playbackFinished)
+		player->pause();
+}
+
+void MediaElement::stop()
+{
+	// a stopped element starts over, its player goes back to the pool meanwhile
+	releasePlayer();
+}
+
+void MediaElement::toggleMute()
+{
+	if(player == 0)
+		return;
+
+	player->setMuted(!player->isMuted());
+}
+
+void MediaElement::destroy()
+{
+	releasePlayer();
+}
+
+void MediaElement::releasePlayer()
+{
+	if(player == 0)
+		return;
+
+	disconnect(player, 0, this, 0);
+	if(pool != 0)
+		pool->release(player);
+	else
+	{
+		player->stop();
+		player->deleteLater();
+	}
+
+	player = 0;
+	playbackFinished = false;
+}
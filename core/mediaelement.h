@@ -0,0 +1,63 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MEDIAELEMENT_H
+#define MEDIAELEMENT_H
+
+#include <QMediaPlayer>
+#include <QPointer>
+
+#include "slideelement.h"
+#include "mediaplayerpool.h"
+
+class MediaElement : public SlideElement
+{
+	Q_OBJECT
+
+public:
+	MediaElement();
+	MediaElement(const MediaElement &copy);
+	~MediaElement();
+	virtual QString previewUrl() const;
+	virtual QStringList assets() const;
+	virtual bool isPlaying() const;
+	void setPlayerPool(MediaPlayerPool *pool);
+
+public slots:
+	virtual void prepare();
+	virtual void play();
+	virtual void pause();
+	virtual void stop();
+	virtual void toggleMute();
+	virtual void destroy();
+
+private slots:
+	void stateChanged(QMediaPlayer::State state);
+
+protected:
+	virtual bool hasOutput() const;
+	virtual void setOutput(QMediaPlayer *player);
+	bool attachPlayer();
+	void releasePlayer();
+
+	QMediaPlayer *player;
+	QPointer<MediaPlayerPool> pool;
+	bool playbackFinished;
+};
+
+#endif // MEDIAELEMENT_H
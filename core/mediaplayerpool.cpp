@@ -0,0 +1,73 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QMediaPlayer>
+#include <QMediaPlaylist>
+#include <QGraphicsVideoItem>
+
+#include "mediaplayerpool.h"
+
+MediaPlayerPool::MediaPlayerPool(const int capacity, QObject *parent) : QObject(parent)
+{
+	this->capacity = capacity;
+	borrowed = 0;
+}
+
+QMediaPlayer *MediaPlayerPool::acquire()
+{
+	// borrowed players are not owned by the pool: the elements holding them may outlive it
+	if(!idle.isEmpty())
+	{
+		QMediaPlayer *player = idle.takeLast();
+		player->setParent(0);
+		borrowed++;
+		return player;
+	}
+
+	if(borrowed >= capacity)
+		return 0;
+
+	borrowed++;
+	return new QMediaPlayer;
+}
+
+void MediaPlayerPool::release(QMediaPlayer *player)
+{
+	// the borrower has already disconnected itself, the player is reset to a blank state
+	borrowed--;
+	player->stop();
+	player->setVideoOutput(static_cast<QGraphicsVideoItem *>(0));
+	player->setMuted(false);
+
+	QMediaPlaylist *playlist = player->playlist();
+	player->setPlaylist(0);
+	delete playlist;
+
+	player->setParent(this);
+	idle << player;
+}
+
+void MediaPlayerPool::reserve(const int count)
+{
+	capacity = qMax(capacity, count);
+}
+
+int MediaPlayerPool::size() const
+{
+	return borrowed + idle.size();
+}
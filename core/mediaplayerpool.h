@@ -0,0 +1,44 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef MEDIAPLAYERPOOL_H
+#define MEDIAPLAYERPOOL_H
+
+#include <QObject>
+#include <QList>
+
+class QMediaPlayer;
+
+class MediaPlayerPool : public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit MediaPlayerPool(const int capacity, QObject *parent = 0);
+	QMediaPlayer *acquire();
+	void release(QMediaPlayer *player);
+	void reserve(const int count);
+	int size() const;
+
+private:
+	int capacity;
+	int borrowed;
+	QList<QMediaPlayer *> idle;
+};
+
+#endif // MEDIAPLAYERPOOL_H
@@ -32,17 +32,28 @@ QGraphicsItem *RectElement::render(const bool interactive)
 	if(!getValue(QStringLiteral("visible")).toBool())
 		return 0;
 
+	GraphicsRectItem *item = new GraphicsRectItem(interactive, this);
+	updateItem(item);
+
+	return item;
+}
+
+bool RectElement::updateItem(QGraphicsItem *graphicsItem)
+{
+	GraphicsRectItem *item = dynamic_cast<GraphicsRectItem *>(graphicsItem);
+	if(item == 0 || !getValue(QStringLiteral("visible")).toBool())
+		return false;
+
 	QPen pen(penStyle());
 	pen.setColor(getValue(QStringLiteral("borderColor")).value<QColor>());
 	pen.setWidth(getValue(QStringLiteral("borderSize")).toInt());
 
-	GraphicsRectItem *item = new GraphicsRectItem(interactive, this);
 	item->setBrush(QBrush(getValue(QStringLiteral("color")).value<QColor>(), brushStyle()));
 	item->setPen(pen);
 	item->setRect(QRect(QPoint(), getValue(QStringLiteral("size")).toSize()));
 	item->setPos(getValue(QStringLiteral("position")).toPoint());
 
-	return item;
+	return true;
 }
 
 PropertyList RectElement::getProperties() const
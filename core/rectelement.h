@@ -31,6 +31,7 @@ class RectElement : public SlideElement
 public:
 	RectElement();
 	virtual QGraphicsItem *render(const bool interactive);
+	virtual bool updateItem(QGraphicsItem *item);
 	virtual PropertyList getProperties() const;
 
 protected:
@@ -0,0 +1,219 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QGraphicsScene>
+#include <QGraphicsPixmapItem>
+#include <QAbstractGraphicsShapeItem>
+
+#include "slideresidency.h"
+#include "slide.h"
+#include "configuration.h"
+
+static qint64 pixmapCost(const QPixmap &pixmap)
+{
+	return qint64(pixmap.width()) * pixmap.height() * pixmap.depth() / 8;
+}
+
+SlideResidency::SlideResidency(QObject *parent) : QObject(parent)
+{
+	budget = qint64(MEMORY_BUDGET) << 20;
+	usage = 0;
+	lastIndex = -1;
+	direction = 1;
+	clock = 0;
+}
+
+void SlideResidency::setBudget(const qint64 bytes)
+{
+	budget = bytes;
+	trim();
+}
+
+qint64 SlideResidency::getBudget() const
+{
+	return budget;
+}
+
+qint64 SlideResidency::getUsage() const
+{
+	return usage;
+}
+
+bool SlideResidency::contains(Slide *slide) const
+{
+	return costs.contains(slide);
+}
+
+QList<Slide *> SlideResidency::residents() const
+{
+	return recent.values();
+}
+
+void SlideResidency::require(Slide *slide)
+{
+	admit(slide);
+	touch(slide);
+}
+
+void SlideResidency::setCost(Slide *slide, const qint64 cost)
+{
+	if(!costs.contains(slide))
+		return;
+
+	usage += cost - costs.value(slide);
+	costs[slide] = cost;
+}
+
+void SlideResidency::update(const QList<Slide *> &slides, const int current)
+{
+	if(current < 0 || current >= slides.size())
+		return;
+
+	if(lastIndex != -1 && current != lastIndex)
+		direction = current > lastIndex ? 1 : -1;
+	lastIndex = current;
+
+	// the current slide is always resident, the look-ahead stops before a slide known to overflow the budget
+	QList<Slide *> window;
+	window << slides[current];
+	qint64 windowCost = admit(slides[current]);
+
+	for(int offset = 1; offset <= PREFETCH_AHEAD && windowCost < budget; offset++)
+	{
+		const int index = current + offset * direction;
+		if(index < 0 || index >= slides.size() || !fits(slides[index], windowCost))
+			break;
+
+		window << slides[index];
+		windowCost += admit(slides[index]);
+	}
+
+	for(int offset = 1; offset <= PREFETCH_BEHIND && windowCost < budget; offset++)
+	{
+		const int index = current - offset * direction;
+		if(index < 0 || index >= slides.size() || !fits(slides[index], windowCost))
+			break;
+
+		window << slides[index];
+		windowCost += admit(slides[index]);
+	}
+	windowSlides = window;
+
+	// the window is ordered by importance: the farthest slides are the first ones to go after the stale ones
+	for(int index = window.size() - 1; index >= 0; index--)
+		touch(window[index]);
+
+	trim();
+}
+
+void SlideResidency::remove(Slide *slide)
+{
+	windowSlides.removeAll(slide);
+	if(costs.contains(slide))
+		drop(slide);
+	lastCosts.remove(slide);
+}
+
+void SlideResidency::evictAll()
+{
+	windowSlides.clear();
+	while(!recent.isEmpty())
+	{
+		Slide *slide = recent.first();
+		drop(slide);
+		emit evict(slide);
+	}
+}
+
+void SlideResidency::clear()
+{
+	recent.clear();
+	stamps.clear();
+	costs.clear();
+	lastCosts.clear();
+	windowSlides.clear();
+	usage = 0;
+	lastIndex = -1;
+	direction = 1;
+}
+
+qint64 SlideResidency::admit(Slide *slide)
+{
+	if(!costs.contains(slide))
+	{
+		// the receiver reports the actual cost with setCost once the slide is populated
+		costs.insert(slide, 0);
+		emit populate(slide);
+	}
+
+	return costs.value(slide);
+}
+
+bool SlideResidency::fits(Slide *slide, const qint64 windowCost) const
+{
+	// the cost a slide had when it was last evicted predicts what populating it again would take
+	return costs.contains(slide) || windowCost + lastCosts.value(slide) <= budget;
+}
+
+void SlideResidency::touch(Slide *slide)
+{
+	// residents are ordered by a stamp, moving one of them does not depend on how many there are
+	if(stamps.contains(slide))
+		recent.remove(stamps.value(slide));
+
+	stamps[slide] = ++clock;
+	recent.insert(clock, slide);
+}
+
+void SlideResidency::drop(Slide *slide)
+{
+	recent.remove(stamps.take(slide));
+	lastCosts[slide] = costs.value(slide);
+	usage -= costs.take(slide);
+}
+
+void SlideResidency::trim()
+{
+	// the slides of the current window stay even over the budget, evicting them would only populate them again
+	while(usage > budget && recent.size() > 1)
+	{
+		Slide *slide = recent.first();
+		if(windowSlides.contains(slide))
+			break;
+
+		drop(slide);
+		emit evict(slide);
+	}
+}
+
+qint64 SlideResidency::sceneCost(const QGraphicsScene *scene)
+{
+	// only the pixels are worth counting, every other item is given a flat cost
+	qint64 cost = 0;
+	foreach(const QGraphicsItem *item, scene->items())
+	{
+		cost += SCENE_ITEM_COST;
+
+		if(const QGraphicsPixmapItem *pixmapItem = dynamic_cast<const QGraphicsPixmapItem *>(item))
+			cost += pixmapCost(pixmapItem->pixmap());
+		else if(const QAbstractGraphicsShapeItem *shapeItem = dynamic_cast<const QAbstractGraphicsShapeItem *>(item))
+			cost += pixmapCost(shapeItem->brush().texture());
+	}
+
+	return cost;
+}
@@ -0,0 +1,73 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SLIDERESIDENCY_H
+#define SLIDERESIDENCY_H
+
+#include <QObject>
+#include <QList>
+#include <QHash>
+#include <QMap>
+
+class QGraphicsScene;
+class Slide;
+
+class SlideResidency : public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit SlideResidency(QObject *parent = 0);
+	void setBudget(const qint64 bytes);
+	qint64 getBudget() const;
+	qint64 getUsage() const;
+	bool contains(Slide *slide) const;
+	QList<Slide *> residents() const;
+	void require(Slide *slide);
+	void setCost(Slide *slide, const qint64 cost);
+	void update(const QList<Slide *> &slides, const int current);
+	void remove(Slide *slide);
+	void evictAll();
+	void clear();
+
+	static qint64 sceneCost(const QGraphicsScene *scene);
+
+signals:
+	void populate(Slide *slide);
+	void evict(Slide *slide);
+
+private:
+	qint64 admit(Slide *slide);
+	bool fits(Slide *slide, const qint64 windowCost) const;
+	void touch(Slide *slide);
+	void drop(Slide *slide);
+	void trim();
+
+	qint64 budget;
+	qint64 usage;
+	int lastIndex;
+	int direction;
+	quint64 clock;
+	QMap<quint64, Slide *> recent;
+	QHash<Slide *, quint64> stamps;
+	QHash<Slide *, qint64> costs;
+	QHash<Slide *, qint64> lastCosts;
+	QList<Slide *> windowSlides;
+};
+
+#endif // SLIDERESIDENCY_H
@@ -0,0 +1,134 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QHash>
+
+#include "slideshowloader.h"
+#include "slideshowreader.h"
+#include "slide.h"
+#include "slideelement.h"
+#include "configuration.h"
+
+SlideshowLoader::SlideshowLoader(const QString &fileName, const QList<int> &elementTypes, QObject *parent) : QThread(parent)
+{
+	qRegisterMetaType<QList<Slide *> >();
+
+	this->file = fileName;
+	this->elementTypes = elementTypes;
+}
+
+QString SlideshowLoader::fileName() const
+{
+	return file;
+}
+
+void SlideshowLoader::run()
+{
+	SlideshowReader reader(file);
+	reader.setElementTypes(elementTypes);
+	connect(&reader, &SlideshowReader::unknownElement, this, &SlideshowLoader::unknownElement, Qt::DirectConnection);
+	connect(&reader, &SlideshowReader::corruptSlide, this, &SlideshowLoader::corruptSlide, Qt::DirectConnection);
+
+	if(!reader.open() || !reader.readIndex())
+	{
+		emit failed(reader.error());
+		return;
+	}
+
+	QVariantMap metadata = reader.metadata();
+	const QList<SlideChunk> chunks = reader.chunks();
+
+	// a recovery journal only holds the edited slides, the others are read from the original file
+	const bool journal = metadata.contains(QStringLiteral("recoveryChunks"));
+	const QVariantList sourceOffsets = metadata.value(QStringLiteral("recoveryChunks")).toList();
+	SlideshowReader source(metadata.value(QStringLiteral("recoverySource")).toString());
+	QHash<qint64, SlideChunk> sourceChunks;
+	if(journal && source.open() && source.readIndex() && source.indexOffset() == metadata.value(QStringLiteral("recoveryIndexOffset")).toLongLong())
+	{
+		foreach(const SlideChunk &chunk, source.chunks())
+			sourceChunks.insert(chunk.offset, chunk);
+	}
+	else
+		metadata.remove(QStringLiteral("recoverySource"));
+
+	const int slidesCount = journal ? sourceOffsets.size() : chunks.size();
+	emit indexLoaded(metadata, slidesCount);
+
+	QThread *target = this->thread();
+	QList<Slide *> batch;
+	int journalIndex = 0;
+	for(int index = 0; index < slidesCount; index++)
+	{
+		if(isInterruptionRequested())
+			break;
+
+		Slide *slide = 0;
+		const qint64 sourceOffset = journal ? sourceOffsets[index].toLongLong() : -1;
+		if(sourceOffset >= 0)
+		{
+			// the original file changed or disappeared since the journal was written
+			if(!sourceChunks.contains(sourceOffset))
+			{
+				emit corruptSlide(QString::number(index + 1));
+				continue;
+			}
+
+			slide = new Slide(0, sourceChunks.value(sourceOffset));
+		}
+		else if(journal)
+		{
+			if(journalIndex >= chunks.size())
+				break;
+
+			// journaled slides are edits: they stay decoded and are saved again
+			slide = new Slide(0, chunks[journalIndex++]);
+			slide->load(&reader);
+			slide->setChunk(SlideChunk());
+			slide->setDirty(true);
+		}
+		else
+		{
+			// the first window is decoded here, the other slides stay stubs until they are shown
+			slide = new Slide(0, chunks[index]);
+			if(index <= PREFETCH_AHEAD)
+				slide->load(&reader);
+		}
+
+		slide->moveToThread(target);
+		if(slide->isLoaded())
+		{
+			foreach(SlideElement *element, slide->getElements())
+				element->moveToThread(target);
+		}
+
+		batch << slide;
+		if(batch.size() == LOAD_BATCH_SIZE)
+		{
+			emit slidesLoaded(batch);
+			batch.clear();
+		}
+	}
+
+	if(!isInterruptionRequested() && !batch.isEmpty())
+	{
+		emit slidesLoaded(batch);
+		batch.clear();
+	}
+
+	qDeleteAll(batch);
+}
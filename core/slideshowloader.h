@@ -0,0 +1,50 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SLIDESHOWLOADER_H
+#define SLIDESHOWLOADER_H
+
+#include <QThread>
+#include <QVariantMap>
+
+class Slide;
+
+class SlideshowLoader : public QThread
+{
+	Q_OBJECT
+
+public:
+	SlideshowLoader(const QString &fileName, const QList<int> &elementTypes, QObject *parent = 0);
+	QString fileName() const;
+
+signals:
+	void indexLoaded(const QVariantMap &metadata, const int slidesCount);
+	void slidesLoaded(const QList<Slide *> &slides);
+	void failed(const int error);
+	void unknownElement(const QString &slideName, const QString &type, const int index);
+	void corruptSlide(const QString &slideName);
+
+protected:
+	virtual void run();
+
+private:
+	QString file;
+	QList<int> elementTypes;
+};
+
+#endif // SLIDESHOWLOADER_H
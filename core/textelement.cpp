@@ -36,14 +36,29 @@ QGraphicsItem *TextElement::render(const bool interactive)
 		return 0;
 
 	GraphicsTextItem *item = new GraphicsTextItem(interactive, this);
-	item->setPlainText(getValue(QStringLiteral("text")).toString());
+	updateItem(item);
+
+	connect(item->document(), &QTextDocument::contentsChanged, this, &TextElement::textChanged);
+	return item;
+}
+
+bool TextElement::updateItem(QGraphicsItem *graphicsItem)
+{
+	GraphicsTextItem *item = dynamic_cast<GraphicsTextItem *>(graphicsItem);
+	if(item == 0 || !getValue(QStringLiteral("visible")).toBool())
+		return false;
+
+	// replacing the document would lose the cursor of an ongoing edition
+	const QString text = getValue(QStringLiteral("text")).toString();
+	if(item->toPlainText() != text)
+		item->setPlainText(text);
+
 	item->setFont(getValue(QStringLiteral("font")).value<QFont>());
 	item->setDefaultTextColor(getValue(QStringLiteral("color")).value<QColor>());
 	item->setTextWidth(getValue(QStringLiteral("width")).toInt());
 	item->setPos(getValue(QStringLiteral("position")).toPoint());
 
-	connect(item->document(), &QTextDocument::contentsChanged, this, &TextElement::textChanged);
-	return item;
+	return true;
 }
 
 PropertyList TextElement::getProperties() const
@@ -33,6 +33,7 @@ class TextElement : public SlideElement
 public:
 	TextElement();
 	virtual QGraphicsItem *render(const bool interactive);
+	virtual bool updateItem(QGraphicsItem *item);
 	virtual PropertyList getProperties() const;
 	
 private slots:
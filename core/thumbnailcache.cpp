@@ -0,0 +1,141 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QStandardPaths>
+#include <QDir>
+#include <QDateTime>
+#include <QSaveFile>
+
+#include "thumbnailcache.h"
+#include "slideshow.h"
+#include "slide.h"
+#include "slideelement.h"
+#include "slideshowreader.h"
+#include "configuration.h"
+
+static const quint16 CACHE_VERSION = 2;
+
+ThumbnailCache::KeyData ThumbnailCache::keyData(const Slide *slide, const QSize &size)
+{
+	KeyData keyData;
+	QDataStream out(&keyData.header, QIODevice::WriteOnly);
+	out.setVersion(QDataStream::Qt_5_0);
+	out << CACHE_VERSION << size << slide->slideshow()->getValue(QStringLiteral("size")).toSize();
+
+	// unchanged slides are identified by their stored chunk, which is only copied here and decoded along with the key
+	const SlideSnapshot snapshot = slide->snapshot();
+	SlideshowReader *source = slide->slideshow()->source();
+	if(!snapshot.chunk.isNull() && source != 0)
+	{
+		const QByteArray data = source->readChunk(snapshot.chunk);
+		keyData.chunk = snapshot.chunk;
+		keyData.data = QByteArray(data.constData(), data.size());
+		keyData.dictionary = source->dictionary();
+	}
+	else
+	{
+		const QList<SlideElement *> elements = slide->getElements();
+		out << slide->getValues() << qint32(elements.size());
+		foreach(const SlideElement *element, elements)
+			out << QByteArray(element->type()) << element->getValues();
+	}
+
+	return keyData;
+}
+
+QByteArray ThumbnailCache::key(const KeyData &keyData)
+{
+	QByteArray header = keyData.header;
+	if(!keyData.chunk.isNull())
+	{
+		// the bytes of a chunk only have a meaning along with the dictionary entries it uses
+		QDataStream out(&header, QIODevice::WriteOnly | QIODevice::Append);
+		out.setVersion(QDataStream::Qt_5_0);
+		out << SlideshowReader::chunkStrings(keyData.chunk, keyData.data, keyData.dictionary) << keyData.chunk.assets;
+	}
+
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	hash.addData(header);
+	hash.addData(keyData.data);
+	return hash.result();
+}
+
+QImage ThumbnailCache::find(const QByteArray &key)
+{
+	QImage image(fileName(key));
+	if(image.isNull())
+		return QImage();
+
+	// files used by the slide must not have changed since the thumbnail was rendered
+	foreach(const QString &entry, image.text(QStringLiteral("assets")).split('\n', QString::SkipEmptyParts))
+	{
+		const QString path = entry.section('|', 1);
+		if(modificationTime(path) != entry.section('|', 0, 0).toLongLong())
+			return QImage();
+	}
+
+	return image;
+}
+
+void ThumbnailCache::insert(const QByteArray &key, QImage image, const QStringList &assets)
+{
+	QStringList entries;
+	foreach(const QString &path, assets)
+		entries << QString::number(modificationTime(path)) + '|' + path;
+	image.setText(QStringLiteral("assets"), entries.join('\n'));
+
+	if(!QDir().mkpath(cachePath()))
+		return;
+
+	QSaveFile file(fileName(key));
+	if(!file.open(QIODevice::WriteOnly) || !image.save(&file, "PNG"))
+		return;
+
+	file.commit();
+}
+
+void ThumbnailCache::prune()
+{
+	const QDateTime expiration = QDateTime::currentDateTime().addDays(-THUMBNAIL_CACHE_AGE);
+
+	QDir directory(cachePath());
+	foreach(const QFileInfo &info, directory.entryInfoList(QDir::Files))
+	{
+		if(info.lastModified() < expiration)
+			directory.remove(info.fileName());
+	}
+}
+
+QString ThumbnailCache::cachePath()
+{
+	const QString cacheLocation = QStandardPaths::writableLocation(QStandardPaths::CacheLocation);
+	return QDir(cacheLocation).filePath(QStringLiteral(THUMBNAIL_CACHE_DIR));
+}
+
+QString ThumbnailCache::fileName(const QByteArray &key)
+{
+	return QDir(cachePath()).filePath(QString::fromLatin1(key.toHex()) + QStringLiteral(".png"));
+}
+
+qint64 ThumbnailCache::modificationTime(const QString &path)
+{
+	const QFileInfo info(path);
+	return info.exists() ? info.lastModified().toMSecsSinceEpoch() : -1;
+}
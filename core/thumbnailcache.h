@@ -0,0 +1,54 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef THUMBNAILCACHE_H
+#define THUMBNAILCACHE_H
+
+#include <QByteArray>
+#include <QImage>
+#include <QStringList>
+
+#include "slidechunk.h"
+#include "propertydictionary.h"
+
+class Slide;
+
+class ThumbnailCache
+{
+public:
+	struct KeyData
+	{
+		QByteArray header;
+		SlideChunk chunk;
+		QByteArray data;
+		PropertyDictionary dictionary;
+	};
+
+	static KeyData keyData(const Slide *slide, const QSize &size);
+	static QByteArray key(const KeyData &keyData);
+	static QImage find(const QByteArray &key);
+	static void insert(const QByteArray &key, QImage image, const QStringList &assets);
+	static void prune();
+
+private:
+	static QString cachePath();
+	static QString fileName(const QByteArray &key);
+	static qint64 modificationTime(const QString &path);
+};
+
+#endif // THUMBNAILCACHE_H
@@ -0,0 +1,153 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QRunnable>
+#include <QPicture>
+#include <QPainter>
+#include <QGraphicsScene>
+
+#include "thumbnailrenderer.h"
+#include "thumbnailcache.h"
+#include "slideshow.h"
+#include "slide.h"
+
+class ThumbnailTask : public QRunnable
+{
+public:
+	ThumbnailTask(ThumbnailRenderer *renderer, const int ticket, const QPicture &picture, const QSize &size, const ThumbnailCache::KeyData &keyData, const QStringList &assets)
+		: renderer(renderer), ticket(ticket), picture(picture), size(size), keyData(keyData), assets(assets) {}
+
+	virtual void run()
+	{
+		QImage image(size, QImage::Format_ARGB32_Premultiplied);
+		image.fill(Qt::white);
+
+		QPainter painter(&image);
+		painter.setRenderHint(QPainter::Antialiasing);
+		painter.setRenderHint(QPainter::SmoothPixmapTransform);
+		painter.drawPicture(0, 0, picture);
+		painter.end();
+
+		QMetaObject::invokeMethod(renderer, "deliver", Qt::QueuedConnection, Q_ARG(int, ticket), Q_ARG(QImage, image));
+		ThumbnailCache::insert(ThumbnailCache::key(keyData), image, assets);
+	}
+
+private:
+	ThumbnailRenderer *renderer;
+	const int ticket;
+	const QPicture picture;
+	const QSize size;
+	const ThumbnailCache::KeyData keyData;
+	const QStringList assets;
+};
+
+class CacheLookupTask : public QRunnable
+{
+public:
+	CacheLookupTask(ThumbnailRenderer *renderer, const int ticket, const ThumbnailCache::KeyData &keyData)
+		: renderer(renderer), ticket(ticket), keyData(keyData) {}
+
+	virtual void run()
+	{
+		QMetaObject::invokeMethod(renderer, "deliver", Qt::QueuedConnection, Q_ARG(int, ticket), Q_ARG(QImage, ThumbnailCache::find(ThumbnailCache::key(keyData))));
+	}
+
+private:
+	ThumbnailRenderer *renderer;
+	const int ticket;
+	const ThumbnailCache::KeyData keyData;
+};
+
+class CachePruneTask : public QRunnable
+{
+public:
+	virtual void run()
+	{
+		ThumbnailCache::prune();
+	}
+};
+
+ThumbnailRenderer::ThumbnailRenderer(QObject *parent) : QObject(parent)
+{
+	lastTicket = 0;
+	pool.start(new CachePruneTask);
+}
+
+ThumbnailRenderer::~ThumbnailRenderer()
+{
+	pool.clear();
+	pool.waitForDone();
+}
+
+QSize ThumbnailRenderer::thumbnailSize(const QSizeF &sceneSize, const int width)
+{
+	return QSize(width, qRound(width * sceneSize.height() / sceneSize.width()));
+}
+
+void ThumbnailRenderer::request(Slide *slide, QGraphicsScene *scene, const int width)
+{
+	// graphics items are not thread-safe: only the recorded paint commands leave the GUI thread
+	const QSize size = thumbnailSize(scene->sceneRect().size(), width);
+
+	QPicture picture;
+	QPainter painter(&picture);
+	scene->render(&painter, QRectF(QPointF(), size), scene->sceneRect());
+	painter.end();
+
+	pool.start(new ThumbnailTask(this, nextTicket(slide), picture, size, ThumbnailCache::keyData(slide, size), slide->assets()));
+}
+
+void ThumbnailRenderer::requestCached(Slide *slide, const int width)
+{
+	// slides which are not loaded can only reuse a thumbnail rendered in a previous session
+	const QSize size = thumbnailSize(slide->slideshow()->getValue(QStringLiteral("size")).toSize(), width);
+	pool.start(new CacheLookupTask(this, nextTicket(slide), ThumbnailCache::keyData(slide, size)));
+}
+
+void ThumbnailRenderer::cancel(Slide *slide)
+{
+	latest.remove(slide);
+}
+
+void ThumbnailRenderer::cancelAll()
+{
+	pool.clear();
+	pending.clear();
+	latest.clear();
+}
+
+int ThumbnailRenderer::nextTicket(Slide *slide)
+{
+	const int ticket = ++lastTicket;
+	pending[ticket] = slide;
+	latest[slide] = ticket;
+
+	return ticket;
+}
+
+void ThumbnailRenderer::deliver(const int ticket, const QImage &image)
+{
+	// results of outdated requests and removed slides are dropped
+	Slide *slide = pending.take(ticket);
+	if(slide == 0 || latest.value(slide) != ticket)
+		return;
+
+	latest.remove(slide);
+	if(!image.isNull())
+		emit thumbnailReady(slide, image);
+}
@@ -0,0 +1,59 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef THUMBNAILRENDERER_H
+#define THUMBNAILRENDERER_H
+
+#include <QObject>
+#include <QThreadPool>
+#include <QHash>
+#include <QImage>
+
+class QGraphicsScene;
+class Slide;
+
+class ThumbnailRenderer : public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit ThumbnailRenderer(QObject *parent = 0);
+	~ThumbnailRenderer();
+	void request(Slide *slide, QGraphicsScene *scene, const int width);
+	void requestCached(Slide *slide, const int width);
+	void cancel(Slide *slide);
+	void cancelAll();
+
+	static QSize thumbnailSize(const QSizeF &sceneSize, const int width);
+
+signals:
+	void thumbnailReady(Slide *slide, const QImage &image);
+
+private slots:
+	void deliver(const int ticket, const QImage &image);
+
+private:
+	int nextTicket(Slide *slide);
+
+	QThreadPool pool;
+	int lastTicket;
+	QHash<int, Slide *> pending;
+	QHash<Slide *, int> latest;
+};
+
+#endif // THUMBNAILRENDERER_H
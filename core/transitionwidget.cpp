@@ -0,0 +1,155 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QPainter>
+
+#include "transitionwidget.h"
+#include "slide.h"
+#include "configuration.h"
+
+TransitionWidget::TransitionWidget(QWidget *parent) : QWidget(parent)
+{
+	type = Slide::NoTransition;
+	duration = 0;
+
+	setAttribute(Qt::WA_OpaquePaintEvent);
+	setAttribute(Qt::WA_TransparentForMouseEvents);
+	hide();
+
+	timer.setSingleShot(true);
+	timer.setTimerType(Qt::PreciseTimer);
+	connect(&timer, &QTimer::timeout, this, &TransitionWidget::step);
+}
+
+void TransitionWidget::start(const QImage &from, const QImage &to, const int type, const int duration)
+{
+	finish();
+
+	// both frames are blended as opaque 32-bit pixels, four bytes per pixel without any conversion in the loop
+	this->from = from.convertToFormat(QImage::Format_RGB32);
+	this->to = to.convertToFormat(QImage::Format_RGB32).scaled(this->from.size());
+	this->frame = QImage(this->from.size(), QImage::Format_RGB32);
+	this->type = type;
+	this->duration = duration;
+
+	clock.start();
+	show();
+	raise();
+	step();
+}
+
+bool TransitionWidget::isRunning() const
+{
+	return isVisible();
+}
+
+void TransitionWidget::finish()
+{
+	if(!isVisible())
+		return;
+
+	timer.stop();
+	hide();
+
+	from = QImage();
+	to = QImage();
+	frame = QImage();
+	emit finished();
+}
+
+void TransitionWidget::step()
+{
+	// the progress follows the clock: slow frames are dropped instead of slowing the effect down
+	const qint64 elapsed = clock.elapsed();
+	if(elapsed >= duration)
+		return finish();
+
+	const qreal progress = qreal(elapsed) / duration;
+	switch(type)
+	{
+		case Slide::Push:
+			push(from, to, &frame, qRound(progress * frame.width()));
+			break;
+		case Slide::Wipe:
+			wipe(from, to, &frame, qRound(progress * frame.width()));
+			break;
+		default:
+			blend(from, to, &frame, qRound(progress * 256));
+			break;
+	}
+	repaint();
+
+	// the next frame waits for the rest of the interval, input events are handled in between
+	const qint64 spent = clock.elapsed() - elapsed;
+	timer.start(qMax<qint64>(0, TRANSITION_INTERVAL - spent));
+}
+
+void TransitionWidget::paintEvent(QPaintEvent *)
+{
+	QPainter painter(this);
+	painter.drawImage(0, 0, frame);
+}
+
+void TransitionWidget::blend(const QImage &from, const QImage &to, QImage *frame, const int alpha)
+{
+	// two channels are blended at once in each half of the pixel, the inner loop has no branch
+	const quint32 inverse = 256 - alpha;
+	const int width = frame->width();
+	const int height = frame->height();
+	for(int y = 0; y < height; y++)
+	{
+		const quint32 *a = reinterpret_cast<const quint32 *>(from.constScanLine(y));
+		const quint32 *b = reinterpret_cast<const quint32 *>(to.constScanLine(y));
+		quint32 *out = reinterpret_cast<quint32 *>(frame->scanLine(y));
+
+		for(int x = 0; x < width; x++)
+		{
+			const quint32 rb = (((a[x] & 0x00FF00FF) * inverse + (b[x] & 0x00FF00FF) * alpha) >> 8) & 0x00FF00FF;
+			const quint32 ag = (((a[x] >> 8) & 0x00FF00FF) * inverse + ((b[x] >> 8) & 0x00FF00FF) * alpha) & 0xFF00FF00;
+			out[x] = rb | ag;
+		}
+	}
+}
+
+void TransitionWidget::push(const QImage &from, const QImage &to, QImage *frame, const int offset)
+{
+	// the old slide leaves on the left while the new one comes in from the right
+	const int width = frame->width();
+	const int height = frame->height();
+	const int kept = width - qBound(0, offset, width);
+	for(int y = 0; y < height; y++)
+	{
+		quint32 *out = reinterpret_cast<quint32 *>(frame->scanLine(y));
+		memcpy(out, reinterpret_cast<const quint32 *>(from.constScanLine(y)) + (width - kept), kept * sizeof(quint32));
+		memcpy(out + kept, to.constScanLine(y), (width - kept) * sizeof(quint32));
+	}
+}
+
+void TransitionWidget::wipe(const QImage &from, const QImage &to, QImage *frame, const int edge)
+{
+	// the new slide is uncovered from left to right
+	const int width = frame->width();
+	const int height = frame->height();
+	const int shown = qBound(0, edge, width);
+	for(int y = 0; y < height; y++)
+	{
+		quint32 *out = reinterpret_cast<quint32 *>(frame->scanLine(y));
+		memcpy(out, to.constScanLine(y), shown * sizeof(quint32));
+		memcpy(out + shown, reinterpret_cast<const quint32 *>(from.constScanLine(y)) + shown, (width - shown) * sizeof(quint32));
+	}
+}
@@ -0,0 +1,62 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef TRANSITIONWIDGET_H
+#define TRANSITIONWIDGET_H
+
+#include <QWidget>
+#include <QImage>
+#include <QTimer>
+#include <QElapsedTimer>
+
+class TransitionWidget : public QWidget
+{
+	Q_OBJECT
+
+public:
+	explicit TransitionWidget(QWidget *parent = 0);
+	void start(const QImage &from, const QImage &to, const int type, const int duration);
+	bool isRunning() const;
+
+	static void blend(const QImage &from, const QImage &to, QImage *frame, const int alpha);
+	static void push(const QImage &from, const QImage &to, QImage *frame, const int offset);
+	static void wipe(const QImage &from, const QImage &to, QImage *frame, const int edge);
+
+signals:
+	void finished();
+
+public slots:
+	void finish();
+
+private slots:
+	void step();
+
+protected:
+	void paintEvent(QPaintEvent *);
+
+private:
+	QImage from;
+	QImage to;
+	QImage frame;
+	int type;
+	int duration;
+	QElapsedTimer clock;
+	QTimer timer;
+};
+
+#endif // TRANSITIONWIDGET_H
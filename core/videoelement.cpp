@@ -19,20 +19,19 @@
 #include <QIcon>
 
 #include "videoelement.h"
+#include "slideshow.h"
 #include "propertymanager.h"
 #include "icon_t.h"
 #include "configuration.h"
 
-VideoElement::VideoElement() : SlideElement()
+VideoElement::VideoElement() : MediaElement()
 {
-	playbackFinished = false;
 	setValue(QStringLiteral("size"), QSize(600, 400));
-	setValue(QStringLiteral("volume"), 100);
 }
 
-QString VideoElement::previewUrl() const
+bool VideoElement::isDynamic() const
 {
-	return getValue(QStringLiteral("src")).toString();
+	return getValue(QStringLiteral("visible")).toBool();
 }
 
 QGraphicsItem *VideoElement::render(const bool interactive)
@@ -90,17 +89,9 @@ QGraphicsItem *VideoElement::render(const bool interactive)
 		item->setPos(pos);
 		item->setAspectRatioMode(scaleMode);
 
-		player = new QMediaPlayer;
-		player->setVideoOutput(item);
-		player->setVolume(getValue(QStringLiteral("volume")).toInt());
-		connect(player, &QMediaPlayer::stateChanged, this, &VideoElement::stateChanged);
-
-		QMediaPlaylist *playlist = new QMediaPlaylist(player);
-		playlist->addMedia(QUrl::fromLocalFile(getValue(QStringLiteral("src")).toString()));
-		if(getValue(QStringLiteral("loop")).toBool())
-			playlist->setPlaybackMode(QMediaPlaylist::CurrentItemInLoop);
-		player->setPlaylist(playlist);
-
+		// a player is attached once the viewer prepares or plays the slide
+		releasePlayer();
+		videoItem = item;
 		return item;
 	}
 }
@@ -151,42 +142,12 @@ PropertyList VideoElement::getProperties() const
 		<< group;
 }
 
-void VideoElement::stateChanged(QMediaPlayer::State state)
-{
-	if(state == QMediaPlayer::StoppedState)
-		playbackFinished = true;
-}
-
-void VideoElement::play()
-{
-	if(!playbackFinished)
-	{
-		qApp->processEvents();
-		player->play();
-	}
-}
-
-void VideoElement::pause()
-{
-	if(!playbackFinished)
-	{
-		qApp->processEvents();
-		player->pause();
-	}
-}
-
-void VideoElement::stop()
-{
-	player->stop();
-	playbackFinished = false;
-}
-
-void VideoElement::toggleMute()
+bool VideoElement::hasOutput() const
 {
-	player->setMuted(!player->isMuted());
+	return videoItem != 0;
 }
 
-void VideoElement::destroy()
+void VideoElement::setOutput(QMediaPlayer *player)
 {
-	player->deleteLater();
+	player->setVideoOutput(videoItem.data());
 }
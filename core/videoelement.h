@@ -19,39 +19,30 @@
 #ifndef VIDEOELEMENT_H
 #define VIDEOELEMENT_H
 
-#include <QMediaPlayer>
+#include <QPointer>
 #include <QGraphicsVideoItem>
 #include <QGraphicsRectItem>
 #include <QPainter>
-#include <QMediaPlaylist>
 #include <QApplication>
 
-#include "slideelement.h"
+#include "mediaelement.h"
 #include "graphicsitem.h"
 
-class VideoElement : public SlideElement
+class VideoElement : public MediaElement
 {
 	Q_OBJECT
 
 public:
 	VideoElement();
-	virtual QString previewUrl() const;
 	virtual QGraphicsItem *render(const bool interactive);
+	virtual bool isDynamic() const;
 	virtual PropertyList getProperties() const;
 
-public slots:
-	virtual void play();
-	virtual void pause();
-	virtual void stop();
-	virtual void toggleMute();
-	virtual void destroy();
-
-private slots:
-	void stateChanged(QMediaPlayer::State state);
-
 protected:
-	QMediaPlayer *player;
-	bool playbackFinished;
+	virtual bool hasOutput() const;
+	virtual void setOutput(QMediaPlayer *player);
+
+	QPointer<QGraphicsVideoItem> videoItem;
 };
 
 class MoviePlaceholderItem : public QGraphicsRectItem
@@ -17,22 +17,47 @@
  */
 
 #include <QGraphicsView>
+#include <QGraphicsPixmapItem>
+#include <QPainter>
 #include <QProgressDialog>
 #include <QInputDialog>
 #include <QShortcut>
-#include <QTimer>
 #include <QMenu>
+#include <QSettings>
 
 #include "viewwidget.h"
 #include "ui_viewwidget.h"
 #include "slideshow.h"
 #include "slide.h"
+#include "slideelement.h"
+#include "slideresidency.h"
+#include "assetprefetcher.h"
+#include "transitionwidget.h"
+#include "mediaplayerpool.h"
+#include "mediaelement.h"
 #include "icon_t.h"
 #include "configuration.h"
 
 ViewWidget::ViewWidget(QWidget *parent) : QWidget(parent), ui(new Ui::ViewWidget)
 {
 	ui->setupUi(this);
+	transition = new TransitionWidget(this);
+	players = new MediaPlayerPool(MEDIA_POOL_SIZE, this);
+	preparedSlide = 0;
+
+	// the schedule follows a monotonic clock, the time spent rendering a slide counts in its duration
+	paused = true;
+	slideElapsed = 0;
+	advanceTimer.setSingleShot(true);
+	advanceTimer.setTimerType(Qt::PreciseTimer);
+	connect(&advanceTimer, &QTimer::timeout, this, &ViewWidget::advance);
+	preloadTimer.setSingleShot(true);
+	connect(&preloadTimer, &QTimer::timeout, this, &ViewWidget::preloadNext);
+
+	residency = new SlideResidency(this);
+	residency->setBudget(QSettings().value(QStringLiteral("memoryBudget"), MEMORY_BUDGET).toLongLong() << 20);
+	connect(residency, &SlideResidency::populate, this, &ViewWidget::populateSlide);
+	connect(residency, &SlideResidency::evict, this, &ViewWidget::evictSlide);
 
 	contextMenu = new QMenu(this);
 	contextMenu->addAction(ICON_T("go-next"), tr("Diapositive suivante"), this, SLOT(next()), QKeySequence(Qt::Key_Return));
@@ -113,16 +138,18 @@ void ViewWidget::displayContextMenu(const QPoint &pos)
 void ViewWidget::setSlideshow(Slideshow *slideshow, const int startIndex)
 {
 	this->slideshow = slideshow;
+	prefetcher = new AssetPrefetcher(slideshow, this);
+	connect(prefetcher, &AssetPrefetcher::finished, this, &ViewWidget::populateWindow);
+
 	const QRect sceneRect = QRect(QPoint(), slideshow->getValue(QStringLiteral("size")).toSize());
 
-	int index = 0;
-	foreach(Slide *slide, slideshow->getSlides())
+	// slides added to the slideshow afterwards have no scene, they are not shown
+	slides = slideshow->getSlides();
+	foreach(Slide *slide, slides)
 	{
 		QGraphicsScene *scene = new QGraphicsScene(this);
 		scene->setSceneRect(sceneRect);
-
-		if(startIndex == index)
-			slide->render(scene, false);
+		scenes.insert(slide, scene);
 
 		QGraphicsView *view = new QGraphicsView(scene, this);
 		view->setFrameShape(QFrame::NoFrame);
@@ -137,7 +164,6 @@ void ViewWidget::setSlideshow(Slideshow *slideshow, const int startIndex)
 		layout->addWidget(view);
 
 		ui->stackedWidget->addWidget(container);
-		index++;
 	}
 
 	ui->stackedWidget->setCurrentIndex(startIndex);
@@ -149,9 +175,7 @@ void ViewWidget::prev()
 	if(ui->stackedWidget->currentIndex() == 0)
 		return;
 
-	stop();
-	ui->stackedWidget->setCurrentIndex(ui->stackedWidget->currentIndex() - 1);
-	play();
+	showSlide(ui->stackedWidget->currentIndex() - 1);
 }
 
 void ViewWidget::next()
@@ -159,9 +183,7 @@ void ViewWidget::next()
 	if(ui->stackedWidget->currentIndex() == ui->stackedWidget->count() - 1)
 		return;
 
-	stop();
-	ui->stackedWidget->setCurrentIndex(ui->stackedWidget->currentIndex() + 1);
-	play();
+	showSlide(ui->stackedWidget->currentIndex() + 1);
 }
 
 void ViewWidget::first()
@@ -169,9 +191,7 @@ void ViewWidget::first()
 	if(ui->stackedWidget->currentIndex() == 0)
 		return;
 
-	stop();
-	ui->stackedWidget->setCurrentIndex(0);
-	play();
+	showSlide(0);
 }
 
 void ViewWidget::last()
@@ -179,27 +199,63 @@ void ViewWidget::last()
 	if(ui->stackedWidget->currentIndex() == ui->stackedWidget->count() - 1)
 		return;
 
+	showSlide(ui->stackedWidget->count() - 1);
+}
+
+void ViewWidget::showSlide(const int index)
+{
+	// a running transition is completed at once so key presses are never queued behind it
+	transition->finish();
 	stop();
-	ui->stackedWidget->setCurrentIndex(ui->stackedWidget->count() - 1);
+
+	const Slide *slide = slideshow->getSlide(index);
+	const int effect = slide->getValue(QStringLiteral("transition")).toInt();
+	const int duration = slide->getValue(QStringLiteral("transitionDuration")).toInt();
+	const bool animated = effect != Slide::NoTransition && duration > 0 && ui->stackedWidget->isVisible();
+
+	QImage from;
+	if(animated)
+		from = ui->stackedWidget->currentWidget()->grab().toImage();
+
+	ui->stackedWidget->setCurrentIndex(index);
 	play();
+
+	if(animated)
+	{
+		transition->setGeometry(ui->stackedWidget->geometry());
+		transition->start(from, ui->stackedWidget->currentWidget()->grab().toImage(), effect, duration);
+	}
 }
 
 void ViewWidget::play()
 {
+	// the clock starts before the slide is populated, its rendering time is part of its duration
+	if(paused)
+		slideClock.start();
+
+	// the slides around the current one are prefetched once it is displayed
 	const int index = ui->stackedWidget->currentIndex();
-	const QGraphicsView *view = ui->stackedWidget->widget(index)->findChild<QGraphicsView *>();
-	if(view->scene()->items().size() == 0)
-		lazyLoad();
-	else
-		QTimer::singleShot(REFRESH_INTERVAL, this, SLOT(lazyLoad()));
+	Slide *slide = slideshow->getSlide(index);
+	residency->require(slide);
+	QTimer::singleShot(REFRESH_INTERVAL, this, SLOT(lazyLoad()));
+
+	foreach(const SlideElement *element, slide->getElements())
+		connect(element, &SlideElement::finished, this, &ViewWidget::mediaFinished, Qt::UniqueConnection);
 
 	paused = false;
-	slideshow->getSlide(index)->play();
+	slide->play();
+	scheduleAdvance();
+	prepareNext();
 }
 
 void ViewWidget::pause()
 {
+	if(!paused)
+		slideElapsed += slideClock.elapsed();
+
 	paused = true;
+	advanceTimer.stop();
+	preloadTimer.stop();
 	slideshow->getSlide(ui->stackedWidget->currentIndex())->pause();
 }
 
@@ -211,9 +267,101 @@ void ViewWidget::togglePlayPause()
 void ViewWidget::stop()
 {
 	paused = true;
+	slideElapsed = 0;
+	advanceTimer.stop();
+	preloadTimer.stop();
 	slideshow->getSlide(ui->stackedWidget->currentIndex())->stop();
 }
 
+qint64 ViewWidget::shownTime() const
+{
+	return slideElapsed + (paused ? 0 : slideClock.elapsed());
+}
+
+void ViewWidget::scheduleAdvance()
+{
+	if(paused || !slideshow->getValue(QStringLiteral("autoAdvance")).toBool())
+		return;
+
+	// without a duration the slide waits for its media, or for the presenter
+	const int duration = slideshow->getSlide(ui->stackedWidget->currentIndex())->getValue(QStringLiteral("duration")).toInt();
+	if(duration <= 0)
+		return;
+
+	const qint64 remaining = qMax<qint64>(0, duration - shownTime());
+	preloadTimer.start(qMax<qint64>(0, remaining - PRELOAD_LEAD));
+	advanceTimer.start(remaining);
+}
+
+int ViewWidget::upcomingIndex() const
+{
+	const int index = ui->stackedWidget->currentIndex() + 1;
+	if(index < ui->stackedWidget->count())
+		return index;
+	else if(slideshow->getValue(QStringLiteral("loop")).toBool())
+		return 0;
+
+	return -1;
+}
+
+void ViewWidget::prepareNext()
+{
+	// the media of the next slide are buffered so they start on its first displayed frame
+	const int index = upcomingIndex();
+	const int currentIndex = ui->stackedWidget->currentIndex();
+	Slide *slide = index != -1 && index != currentIndex ? slideshow->getSlide(index) : 0;
+
+	// a slide prepared before a jump holds players the pool may not spare
+	if(preparedSlide != 0 && preparedSlide != slide && preparedSlide != slideshow->getSlide(currentIndex))
+		preparedSlide->stop();
+	preparedSlide = 0;
+
+	if(slide != 0 && residency->contains(slide))
+	{
+		slide->prepare();
+		preparedSlide = slide;
+	}
+}
+
+void ViewWidget::preloadNext()
+{
+	// the next slide is ready before its deadline even when the budget only holds the current one
+	const int index = upcomingIndex();
+	if(index != -1)
+		residency->require(slideshow->getSlide(index));
+}
+
+void ViewWidget::advance()
+{
+	if(paused)
+		return;
+
+	// media still playing advance the slide once they end
+	foreach(const SlideElement *element, slideshow->getSlide(ui->stackedWidget->currentIndex())->getElements())
+	{
+		if(element->isPlaying())
+			return;
+	}
+
+	const int index = upcomingIndex();
+	if(index != -1)
+		showSlide(index);
+}
+
+void ViewWidget::mediaFinished()
+{
+	const SlideElement *element = qobject_cast<SlideElement *>(sender());
+	if(paused || element == 0 || element->slide() != slideshow->getSlide(ui->stackedWidget->currentIndex()))
+		return;
+
+	if(!slideshow->getValue(QStringLiteral("autoAdvance")).toBool())
+		return;
+
+	const int duration = element->slide()->getValue(QStringLiteral("duration")).toInt();
+	if(shownTime() >= duration)
+		advance();
+}
+
 void ViewWidget::toggleMute()
 {
 	slideshow->getSlide(ui->stackedWidget->currentIndex())->toggleMute();
@@ -242,29 +390,27 @@ void ViewWidget::goTo()
 	if(!ok || name.isEmpty() || slideNames.indexOf(name) == ui->stackedWidget->currentIndex())
 		return play();
 
-	stop();
-	ui->stackedWidget->setCurrentIndex(slideNames.indexOf(name));
-	play();
+	showSlide(slideNames.indexOf(name));
 }
 
 void ViewWidget::toggleBlack()
 {
+	transition->finish();
 	ui->stackedWidget->setVisible(!ui->stackedWidget->isVisible());
 }
 
 void ViewWidget::closeEvent(QCloseEvent *)
 {
-	const int slideCount = slideshow->getSlides().size();
-	for(int index = 0; index < slideCount; index++)
-	{
-		const QGraphicsView *view = ui->stackedWidget->widget(index)->findChild<QGraphicsView *>();
-		if(view->scene()->items().size() == 0)
-			continue;
+	transition->finish();
+	advanceTimer.stop();
+	preloadTimer.stop();
+	residency->evictAll();
+
+	// slides prefetched but never displayed
+	foreach(Slide *slide, loadedSlides)
+		slide->unload();
+	loadedSlides.clear();
 
-		Slide *slide = this->slideshow->getSlide(index);
-		slide->stop();
-		slide->destroy();
-	}
 	emit closed(ui->stackedWidget->currentIndex());
 }
 
@@ -273,23 +419,114 @@ void ViewWidget::lazyLoad()
 	const int currentIndex = ui->stackedWidget->currentIndex();
 	const int slideCount = ui->stackedWidget->count();
 
-	const int keepStart = currentIndex - (MAX_LOADED_SLIDES / 2);
-	const int keepEnd = currentIndex + (MAX_LOADED_SLIDES / 2);
-	for(int index = 0; index < slideCount; index++)
+	// the images of the upcoming slides are decoded on worker threads, the slides are populated once they are ready
+	for(int index = currentIndex + 1; index <= currentIndex + PREFETCH_AHEAD && index < slideCount; index++)
+	{
+		Slide *slide = slideshow->getSlide(index);
+		if(residency->contains(slide))
+			continue;
+
+		if(!slide->isLoaded())
+		{
+			loadedSlides << slide;
+			slide->load();
+		}
+		prefetcher->prefetch(slide);
+	}
+
+	if(!prefetcher->isBusy())
+		populateWindow();
+}
+
+void ViewWidget::populateWindow()
+{
+	residency->update(slides, ui->stackedWidget->currentIndex());
+
+	// slides decoded for their assets but not admitted within the budget are dropped again
+	foreach(Slide *slide, loadedSlides)
+	{
+		if(!residency->contains(slide) && slide->unload())
+			loadedSlides.remove(slide);
+	}
+}
+
+void ViewWidget::populateSlide(Slide *slide)
+{
+	QGraphicsScene *scene = scenes.value(slide);
+
+	if(!slide->isLoaded())
+		loadedSlides << slide;
+
+	// media elements borrow their players from the viewer, which holds enough of them for any single slide
+	int mediaCount = 0;
+	foreach(SlideElement *element, slide->getElements())
 	{
-		const QGraphicsView *view = ui->stackedWidget->widget(index)->findChild<QGraphicsView *>();
-		Slide *slide = this->slideshow->getSlide(index);
+		MediaElement *media = qobject_cast<MediaElement *>(element);
+		if(media != 0)
+		{
+			media->setPlayerPool(players);
+			mediaCount++;
+		}
+	}
+	players->reserve(mediaCount);
 
-		if(index < keepStart || index > keepEnd)
+	slide->render(scene, false);
+	flattenScene(scene, slide->dynamicLayer());
+	residency->setCost(slide, SlideResidency::sceneCost(scene));
+
+	if(slideshow->indexOf(slide) == upcomingIndex())
+		prepareNext();
+}
+
+void ViewWidget::flattenScene(QGraphicsScene *scene, const int dynamicLayer)
+{
+	// static items are drawn once at screen resolution, only the media above them stay live
+	QList<QGraphicsItem *> staticItems;
+	QList<QGraphicsItem *> hiddenItems;
+	foreach(QGraphicsItem *item, scene->items())
+	{
+		if(item->parentItem() != 0)
+			continue;
+
+		if(dynamicLayer == -1 || item->zValue() < dynamicLayer)
+			staticItems << item;
+		else if(item->isVisible())
 		{
-			if(view->scene()->items().size() > 0)
-			{
-				slide->stop();
-				slide->destroy();
-				view->scene()->clear();
-			}
+			hiddenItems << item;
+			item->hide();
 		}
-		else if(view->scene()->items().size() == 0)
-			slide->render(view->scene(), false);
 	}
+
+	if(staticItems.isEmpty())
+		return;
+
+	QImage image(scene->sceneRect().size().toSize(), QImage::Format_ARGB32_Premultiplied);
+	image.fill(Qt::transparent);
+
+	QPainter painter(&image);
+	painter.setRenderHints(QPainter::Antialiasing | QPainter::TextAntialiasing | QPainter::SmoothPixmapTransform);
+	scene->render(&painter, QRectF(image.rect()), scene->sceneRect());
+	painter.end();
+
+	qDeleteAll(staticItems);
+	foreach(QGraphicsItem *item, hiddenItems)
+		item->show();
+
+	QGraphicsPixmapItem *frame = scene->addPixmap(QPixmap::fromImage(image));
+	frame->setPos(scene->sceneRect().topLeft());
+	frame->setZValue(-1);
+}
+
+void ViewWidget::evictSlide(Slide *slide)
+{
+	if(slide == preparedSlide)
+		preparedSlide = 0;
+
+	slide->stop();
+	slide->destroy();
+	scenes.value(slide)->clear();
+
+	// the editor only keeps its own slides decoded
+	if(loadedSlides.remove(slide))
+		slide->unload();
 }
@@ -20,9 +20,19 @@
 #define VIEWWIDGET_H
 
 #include <QWidget>
+#include <QSet>
+#include <QHash>
+#include <QTimer>
+#include <QElapsedTimer>
 
 class QMenu;
+class QGraphicsScene;
 class Slideshow;
+class Slide;
+class SlideResidency;
+class AssetPrefetcher;
+class TransitionWidget;
+class MediaPlayerPool;
 
 namespace Ui
 {
@@ -58,15 +68,39 @@ public slots:
 
 private:
 	Ui::ViewWidget *ui;
+	void showSlide(const int index);
+	void scheduleAdvance();
+	qint64 shownTime() const;
+	int upcomingIndex() const;
+	void prepareNext();
+	void flattenScene(QGraphicsScene *scene, const int dynamicLayer);
 
 private slots:
 	void lazyLoad();
 	void displayContextMenu(const QPoint &pos);
+	void populateSlide(Slide *slide);
+	void evictSlide(Slide *slide);
+	void populateWindow();
+	void advance();
+	void preloadNext();
+	void mediaFinished();
 
 protected:
 	bool paused;
 	Slideshow *slideshow;
 	QMenu *contextMenu;
+	QSet<Slide *> loadedSlides;
+	QList<Slide *> slides;
+	QHash<Slide *, QGraphicsScene *> scenes;
+	SlideResidency *residency;
+	AssetPrefetcher *prefetcher;
+	TransitionWidget *transition;
+	MediaPlayerPool *players;
+	Slide *preparedSlide;
+	QTimer advanceTimer;
+	QTimer preloadTimer;
+	QElapsedTimer slideClock;
+	qint64 slideElapsed;
 	void closeEvent(QCloseEvent *);
 };
 
@@ -32,6 +32,7 @@
 #include "slideshow.h"
 #include "slide.h"
 #include "slideelement.h"
+#include "sliderenderer.h"
 #include "icon_t.h"
 #include "configuration.h"
 
@@ -136,31 +137,16 @@ void ImportExport::launchExport()
 	progress->setMaximum(to);
 	progress->open();
 
+	SlideRenderer renderer(slideshow->getValue(QStringLiteral("size")).toSize());
 	for(int index = from; index <= to; index++)
 	{
 		progress->setValue(index + 1);
 
-		QGraphicsScene *scene = new QGraphicsScene;
-		scene->setSceneRect(QRect(QPoint(), slideshow->getValue(QStringLiteral("size")).toSize()));
-		scene->setItemIndexMethod(QGraphicsScene::NoIndex);
-
-		QPixmap pixmap(scene->sceneRect().size().toSize());
-		QPainter painter(&pixmap);
-		painter.setRenderHint(QPainter::Antialiasing);
-
 		Slide *slide = slideshow->getSlide(index);
-		slide->render(scene, false);
-		scene->render(&painter, scene->sceneRect());
-
-		delete scene;
-
-		QString fileName = fileTemplate;
-		fileName.replace("%n", slide->getValue(QStringLiteral("name")).toString());
-		fileName.replace("%i", QString::number(index + 1));
-		fileName.replace("%s", QFileInfo(window->windowFilePath()).baseName());
-		fileName.replace("%f", format);
+		const QImage image = renderer.render(slide);
+		const QString fileName = SlideRenderer::fileName(fileTemplate, slide, index, QFileInfo(window->windowFilePath()).baseName(), format);
 
-		if(!pixmap.save(directory + "/" + fileName, format.toLocal8Bit().data(), quality))
+		if(!image.save(directory + "/" + fileName, format.toLocal8Bit().data(), quality))
 		{
 			QMessageBox::critical(window, dialog->windowTitle(), tr("Une erreur s'est produite lors de l'enregistrement de %1.").arg(fileName), QMessageBox::Abort);
 			progress->close();
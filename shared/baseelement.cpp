@@ -26,10 +26,12 @@ QVariant BaseElement::getValue(const QString &name, QVariant defaultValue) const
 void BaseElement::setValue(const QString &name, QVariant value)
 {
 	this->properties[name] = value;
+	this->dirty = true;
 }
 
 int BaseElement::unsetValue(const QString &name)
 {
+	this->dirty = true;
 	return this->properties.remove(name);
 }
 
@@ -38,9 +40,21 @@ void BaseElement::setValues(QVariantMap properties)
 	QVariantMap::iterator iterator;
 	for(iterator = properties.begin(); iterator != properties.end(); ++iterator)
 		this->properties[iterator.key()] = iterator.value();
+
+	this->dirty = true;
 }
 
 QVariantMap BaseElement::getValues() const
 {
 	return this->properties;
 }
+
+bool BaseElement::isDirty() const
+{
+	return this->dirty;
+}
+
+void BaseElement::setDirty(const bool dirty)
+{
+	this->dirty = dirty;
+}
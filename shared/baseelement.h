@@ -30,14 +30,17 @@ class CFISLIDES_DLLSPEC BaseElement : public QObject
 	Q_OBJECT
 
 public:
-	BaseElement() : QObject() {}
+	BaseElement() : QObject() { dirty = false; }
 	QVariant getValue(const QString &name, QVariant defaultValue = QVariant()) const;
 	void setValue(const QString &name, QVariant value);
 	int unsetValue(const QString &name);
 	QVariantMap getValues() const;
 	void setValues(QVariantMap);
+	virtual bool isDirty() const;
+	virtual void setDirty(const bool dirty);
 
 private:
 	QVariantMap properties;
+	bool dirty;
 };
 #endif // BASEELEMENT_H
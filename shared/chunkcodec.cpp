@@ -0,0 +1,88 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QHash>
+
+#include "chunkcodec.h"
+#include "slidechunk.h"
+#include "configuration.h"
+
+static QHash<int, ChunkCodec *> builtinCodecs()
+{
+	QHash<int, ChunkCodec *> registry;
+	registry[SlideChunk::ZlibCodec] = new ZlibCodec;
+	return registry;
+}
+
+static QHash<int, ChunkCodec *> &codecs()
+{
+	// filled by the initializer so the first calls from the loader, journal and gui threads are serialized
+	static QHash<int, ChunkCodec *> registry = builtinCodecs();
+	return registry;
+}
+
+void ChunkCodec::registerCodec(ChunkCodec *codec)
+{
+	// the identifier is stored in the high nibble of the chunk flags
+	const int id = codec->id() & SlideChunk::CodecMask;
+	if(id == SlideChunk::NoCodec || codecs().contains(id))
+	{
+		delete codec;
+		return;
+	}
+
+	codecs()[id] = codec;
+}
+
+bool ChunkCodec::isSupported(const int id)
+{
+	return id == SlideChunk::NoCodec || codecs().contains(id);
+}
+
+QByteArray ChunkCodec::encode(const int id, const QByteArray &data)
+{
+	if(id == SlideChunk::NoCodec)
+		return data;
+
+	const ChunkCodec *codec = codecs().value(id);
+	return codec != 0 ? codec->compress(data) : QByteArray();
+}
+
+QByteArray ChunkCodec::decode(const int id, const QByteArray &data)
+{
+	if(id == SlideChunk::NoCodec)
+		return data;
+
+	const ChunkCodec *codec = codecs().value(id);
+	return codec != 0 ? codec->uncompress(data) : QByteArray();
+}
+
+int ZlibCodec::id() const
+{
+	return SlideChunk::ZlibCodec;
+}
+
+QByteArray ZlibCodec::compress(const QByteArray &data) const
+{
+	return qCompress(data, COMPRESSION_LEVEL);
+}
+
+QByteArray ZlibCodec::uncompress(const QByteArray &data) const
+{
+	return qUncompress(data);
+}
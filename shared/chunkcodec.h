@@ -0,0 +1,48 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef CHUNKCODEC_H
+#define CHUNKCODEC_H
+
+#include <QByteArray>
+
+#include "shared.h"
+
+class CFISLIDES_DLLSPEC ChunkCodec
+{
+public:
+	virtual ~ChunkCodec() {}
+	virtual int id() const = 0;
+	virtual QByteArray compress(const QByteArray &data) const = 0;
+	virtual QByteArray uncompress(const QByteArray &data) const = 0;
+
+	static void registerCodec(ChunkCodec *codec);
+	static bool isSupported(const int id);
+	static QByteArray encode(const int id, const QByteArray &data);
+	static QByteArray decode(const int id, const QByteArray &data);
+};
+
+class CFISLIDES_DLLSPEC ZlibCodec : public ChunkCodec
+{
+public:
+	int id() const;
+	QByteArray compress(const QByteArray &data) const;
+	QByteArray uncompress(const QByteArray &data) const;
+};
+
+#endif // CHUNKCODEC_H
@@ -36,6 +36,30 @@
 #define REFRESH_INTERVAL       100
 #define PLUGINS_PATH           QCoreApplication::applicationDirPath() + "/plugins/"
 #define RECENT_FILES_MAX       6
-#define MAX_LOADED_SLIDES      20
+#define MEMORY_BUDGET          256 // MiB
+#define PREFETCH_AHEAD         8
+#define PREFETCH_BEHIND        2
+#define SCENE_ITEM_COST        4096
+#define PREFETCH_LEVEL_SIZE    128
+#define TRANSITION_DURATION    500
+#define TRANSITION_INTERVAL    16
+#define PRELOAD_LEAD           1000
+#define MEDIA_POOL_SIZE        4
+#define LOAD_BATCH_SIZE        10
+#define FILE_MAGIC             0x43534C53 // "CSLS"
+#define FILE_VERSION           6
+#define INDEX_MAGIC            0x43534C49 // "CSLI"
+#define COMPACT_RATIO          0.5
+#define COPY_BUFFER_SIZE       65536
+#define COMPRESSION_LEVEL      6
+#define AUTOSAVE_INTERVAL      60000
+#define JOURNAL_FILE           "recovery.csl"
+#define RECOVERED_FILE         "recovered.csl"
+#define THUMBNAIL_CACHE_DIR    "thumbnails"
+#define THUMBNAIL_CACHE_AGE    30
+#define IMAGE_CACHE_SIZE       65536 // KiB
+#define RENDER_INTERVAL        16
+#define RENDER_BATCH_SIZE      10
+#define ICON_UPDATE_DELAY      300
 
 #endif // CONFIGURATION_H
@@ -32,10 +32,15 @@ public:\
 			this->setFlags(QGraphicsItem::ItemIsSelectable | QGraphicsItem::ItemIsMovable | QGraphicsItem::ItemSendsGeometryChanges);\
 	}\
 \
-private:\
-	SlideElement *slideElement;\
+	~className()\
+	{\
+		if(this->slideElement != 0 && this->slideElement->graphicsItem() == this)\
+			this->slideElement->setGraphicsItem(0);\
+	}\
 \
 protected:\
+	SlideElement *slideElement;\
+\
 	virtual QVariant itemChange(GraphicsItemChange change, const QVariant &value)\
 	{\
 		if(change != ItemPositionChange || !scene())\
@@ -0,0 +1,92 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <climits>
+
+#include "imagecache.h"
+
+ImageCache::ImageCache(const int maxCost) : levels(maxCost)
+{
+}
+
+bool ImageCache::contains(const QString &key) const
+{
+	return levels.contains(key);
+}
+
+bool ImageCache::fits(const QSize &size, const int depth) const
+{
+	return cost(size, depth) <= levels.maxCost();
+}
+
+bool ImageCache::insert(const QString &key, const QPixmap &pixmap)
+{
+	if(pixmap.isNull())
+		return false;
+
+	// an image larger than the whole cache is refused, the caller keeps using its own copy
+	return levels.insert(key, new QList<QPixmap>() << pixmap, cost(pixmap.size(), pixmap.depth()));
+}
+
+bool ImageCache::insert(const QString &key, const QList<QPixmap> &chain)
+{
+	if(chain.isEmpty() || chain.first().isNull())
+		return false;
+
+	// levels built in advance are kept, the missing smaller ones are still added on demand
+	const QPixmap &pixmap = chain.first();
+	return levels.insert(key, new QList<QPixmap>(chain), cost(pixmap.size(), pixmap.depth()));
+}
+
+QPixmap ImageCache::pixmap(const QString &key, const QSize &size)
+{
+	QList<QPixmap> *chain = levels.object(key);
+	if(chain == 0)
+		return QPixmap();
+
+	if(size.isEmpty())
+		return chain->first();
+
+	// each level is half the size of the previous one: the returned level is at most twice the requested size
+	while(chain->last().width() >= size.width() * 2 && chain->last().height() >= size.height() * 2)
+	{
+		const QPixmap &last = chain->last();
+		*chain << last.scaled(last.width() / 2, last.height() / 2, Qt::IgnoreAspectRatio, Qt::SmoothTransformation);
+	}
+
+	for(int index = chain->size() - 1; index > 0; index--)
+	{
+		const QPixmap &level = chain->at(index);
+		if(level.width() >= size.width() && level.height() >= size.height())
+			return level;
+	}
+
+	return chain->first();
+}
+
+void ImageCache::clear()
+{
+	levels.clear();
+}
+
+int ImageCache::cost(const QSize &size, const int depth)
+{
+	// the cost is counted in kilobytes, including a full chain of smaller levels
+	const qint64 bytes = qint64(size.width()) * size.height() * depth / 8;
+	return int(qBound(Q_INT64_C(1), bytes / 1024 * 4 / 3, qint64(INT_MAX)));
+}
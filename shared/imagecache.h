@@ -0,0 +1,44 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef IMAGECACHE_H
+#define IMAGECACHE_H
+
+#include <QCache>
+#include <QPixmap>
+
+#include "shared.h"
+
+class CFISLIDES_DLLSPEC ImageCache
+{
+public:
+	explicit ImageCache(const int maxCost);
+	bool contains(const QString &key) const;
+	bool fits(const QSize &size, const int depth) const;
+	bool insert(const QString &key, const QPixmap &pixmap);
+	bool insert(const QString &key, const QList<QPixmap> &chain);
+	QPixmap pixmap(const QString &key, const QSize &size = QSize());
+	void clear();
+
+private:
+	static int cost(const QSize &size, const int depth);
+
+	QCache<QString, QList<QPixmap> > levels;
+};
+
+#endif // IMAGECACHE_H
@@ -0,0 +1,179 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QDataStream>
+#include <QPoint>
+#include <QSize>
+#include <QColor>
+
+#include "propertydictionary.h"
+
+static const int MAX_STRINGS = 0xFFFF;
+
+PropertyDictionary::PropertyDictionary(const QStringList &strings)
+{
+	foreach(const QString &string, strings)
+		indexOf(string);
+}
+
+QStringList PropertyDictionary::strings() const
+{
+	return dictionary;
+}
+
+int PropertyDictionary::indexOf(const QString &string)
+{
+	// strings are only ever appended: the chunks already written keep their indexes
+	const int index = indexes.value(string, -1);
+	if(index != -1 || dictionary.size() >= MAX_STRINGS)
+		return index;
+
+	indexes[string] = dictionary.size();
+	dictionary << string;
+	return dictionary.size() - 1;
+}
+
+QString PropertyDictionary::string(const int index) const
+{
+	return dictionary.value(index);
+}
+
+bool PropertyDictionary::writeMap(QDataStream &out, const QVariantMap &map)
+{
+	out << quint16(map.size());
+
+	QVariantMap::const_iterator iterator;
+	for(iterator = map.constBegin(); iterator != map.constEnd(); ++iterator)
+	{
+		const int key = indexOf(iterator.key());
+		if(key == -1)
+			return false;
+
+		out << quint16(key);
+
+		const QVariant &value = iterator.value();
+		switch(value.type())
+		{
+			case QVariant::Int:
+				out << quint8(IntTag) << qint32(value.toInt());
+				continue;
+			case QVariant::Bool:
+				out << quint8(value.toBool() ? TrueTag : FalseTag);
+				continue;
+			case QVariant::Point:
+				out << quint8(PointTag) << qint32(value.toPoint().x()) << qint32(value.toPoint().y());
+				continue;
+			case QVariant::Size:
+				out << quint8(SizeTag) << qint32(value.toSize().width()) << qint32(value.toSize().height());
+				continue;
+			case QVariant::String:
+				out << quint8(StringTag) << value.toString();
+				continue;
+			case QVariant::Color:
+			{
+				// only 8 bits RGB colors survive the packing unchanged
+				const QColor color = value.value<QColor>();
+				if(color.spec() == QColor::Rgb && QColor::fromRgba(color.rgba()) == color)
+				{
+					out << quint8(ColorTag) << quint32(color.rgba());
+					continue;
+				}
+				break;
+			}
+			default:
+				break;
+		}
+
+		out << quint8(VariantTag) << value;
+	}
+
+	return true;
+}
+
+QVariantMap PropertyDictionary::readMap(QDataStream &in) const
+{
+	QVariantMap map;
+
+	quint16 count = 0;
+	in >> count;
+	for(int index = 0; index < count && in.status() == QDataStream::Ok; index++)
+	{
+		quint16 key = 0;
+		quint8 tag = VariantTag;
+		in >> key >> tag;
+		if(key >= dictionary.size())
+		{
+			in.setStatus(QDataStream::ReadCorruptData);
+			break;
+		}
+
+		QVariant value;
+		switch(tag)
+		{
+			case IntTag:
+			{
+				qint32 number = 0;
+				in >> number;
+				value = int(number);
+				break;
+			}
+			case FalseTag:
+			case TrueTag:
+				value = tag == TrueTag;
+				break;
+			case PointTag:
+			{
+				qint32 x = 0, y = 0;
+				in >> x >> y;
+				value = QPoint(x, y);
+				break;
+			}
+			case SizeTag:
+			{
+				qint32 width = 0, height = 0;
+				in >> width >> height;
+				value = QSize(width, height);
+				break;
+			}
+			case ColorTag:
+			{
+				quint32 rgba = 0;
+				in >> rgba;
+				value = QColor::fromRgba(rgba);
+				break;
+			}
+			case StringTag:
+			{
+				QString string;
+				in >> string;
+				value = string;
+				break;
+			}
+			case VariantTag:
+				in >> value;
+				break;
+			default:
+				in.setStatus(QDataStream::ReadCorruptData);
+				break;
+		}
+
+		map.insert(dictionary[key], value);
+	}
+
+	return map;
+}
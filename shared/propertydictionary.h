@@ -0,0 +1,58 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef PROPERTYDICTIONARY_H
+#define PROPERTYDICTIONARY_H
+
+#include <QStringList>
+#include <QHash>
+#include <QVariantMap>
+
+#include "shared.h"
+
+class QDataStream;
+
+class CFISLIDES_DLLSPEC PropertyDictionary
+{
+public:
+	enum Tag
+	{
+		VariantTag,
+		IntTag,
+		FalseTag,
+		TrueTag,
+		PointTag,
+		SizeTag,
+		ColorTag,
+		StringTag
+	};
+
+	PropertyDictionary() {}
+	explicit PropertyDictionary(const QStringList &strings);
+	QStringList strings() const;
+	int indexOf(const QString &string);
+	QString string(const int index) const;
+	bool writeMap(QDataStream &out, const QVariantMap &map);
+	QVariantMap readMap(QDataStream &in) const;
+
+private:
+	QStringList dictionary;
+	QHash<QString, int> indexes;
+};
+
+#endif // PROPERTYDICTIONARY_H
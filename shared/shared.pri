@@ -21,6 +21,14 @@ cfislides-uselib:!cfislides-buildlib {
 		propertyeditor.h \
 		propertyeditordelegate.h \
 		icon_t.h \
+		slidechunk.h \
+		slidesnapshot.h \
+		slideshowreader.h \
+		slideshowwriter.h \
+		propertydictionary.h \
+		chunkcodec.h \
+		sliderenderer.h \
+		imagecache.h \
 
 	SOURCES += \
 		slideshow.cpp \
@@ -34,6 +42,12 @@ cfislides-uselib:!cfislides-buildlib {
 		propertymanager.cpp \
 		propertyeditor.cpp \
 		propertyeditordelegate.cpp \
+		slideshowreader.cpp \
+		slideshowwriter.cpp \
+		propertydictionary.cpp \
+		chunkcodec.cpp \
+		sliderenderer.cpp \
+		imagecache.cpp \
 
 	FORMS += \
 		textinputdialog.ui \
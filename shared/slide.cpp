@@ -17,17 +17,33 @@
  */
 
 #include <QGraphicsScene>
+#include <QGraphicsRectItem>
 
 #include "slide.h"
 #include "slideelement.h"
+#include "slideshow.h"
+#include "slideshowreader.h"
 #include "configuration.h"
 #include "propertymanager.h"
 
 Slide::Slide(Slideshow *slideshow) : SlideshowElement()
 {
 	parentSlideshow = slideshow;
+	loaded = true;
 	setValue(QStringLiteral("name"), tr("Sans Nom"));
 	setValue(QStringLiteral("backgroundColor"), QColor(Qt::white));
+	setValue(QStringLiteral("transition"), Slide::NoTransition);
+	setValue(QStringLiteral("transitionDuration"), TRANSITION_DURATION);
+	setValue(QStringLiteral("duration"), 0);
+}
+
+Slide::Slide(Slideshow *slideshow, const SlideChunk &chunk) : Slide(slideshow)
+{
+	// only the name is known until the elements are decoded by load()
+	slideChunk = chunk;
+	loaded = false;
+	setValue(QStringLiteral("name"), chunk.name);
+	setDirty(false);
 }
 
 Slide::~Slide()
@@ -38,14 +54,19 @@ Slide::~Slide()
 
 void Slide::render(QGraphicsScene *scene, const bool interactive) const
 {
+	const_cast<Slide *>(this)->load();
+
 	QBrush background;
 	background.setColor(getValue(QStringLiteral("backgroundColor")).value<QColor>());
 	background.setStyle(Qt::SolidPattern);
 
-	QPixmap backgroundPixmap(this->getValue(QStringLiteral("backgroundImage")).toString());
+	// stretched backgrounds are scaled from the smallest level which is still larger than the scene
+	const int stretch = getValue(QStringLiteral("backgroundImageStretch")).toInt();
+	const QSize levelSize = stretch == Slide::Repeat ? QSize() : scene->sceneRect().size().toSize();
+	QPixmap backgroundPixmap = parentSlideshow->pixmap(this->getValue(QStringLiteral("backgroundImage")).toString(), levelSize);
 	if(!backgroundPixmap.isNull())
 	{
-		switch(getValue(QStringLiteral("backgroundImageStretch")).toInt())
+		switch(stretch)
 		{
 			case Slide::Repeat:
 				break;
@@ -62,29 +83,58 @@ void Slide::render(QGraphicsScene *scene, const bool interactive) const
 		background.setTexture(backgroundPixmap);
 	}
 
-	scene->addRect(scene->sceneRect(), QPen(Qt::NoPen), background);
+	scene->addRect(scene->sceneRect(), QPen(Qt::NoPen), background)->setZValue(-1);
 
+	// items of the editor scene stay attached to their element to be updated in place
 	foreach(SlideElement *element, elements)
 	{
 		QGraphicsItem *item = element->render(interactive);
 		if(!item) continue;
 
+		item->setZValue(element->getIndex());
+		if(interactive)
+			element->setGraphicsItem(item);
 		scene->addItem(item);
 	}
 }
 
+void Slide::updateElement(SlideElement *element, QGraphicsScene *scene)
+{
+	QGraphicsItem *item = element->graphicsItem();
+	if(item != 0 && element->updateItem(item))
+		return;
+
+	// the element cannot be patched in place (its item type changed): only its own item is rebuilt
+	const bool selected = item != 0 && item->isSelected();
+	delete item;
+
+	item = element->render(true);
+	element->setGraphicsItem(item);
+	if(!item)
+		return;
+
+	item->setZValue(element->getIndex());
+	scene->addItem(item);
+	item->setSelected(selected);
+}
+
 QList<SlideElement *> Slide::getElements() const
 {
+	const_cast<Slide *>(this)->load();
 	return elements;
 }
 
 SlideElement *Slide::getElement(const int index) const
 {
+	const_cast<Slide *>(this)->load();
 	return elements[index];
 }
 
 void Slide::addElement(SlideElement *element)
 {
+	load();
+	setDirty(true);
+
 	element->setIndex(elements.size());
 	element->setSlide(this);
 
@@ -98,6 +148,8 @@ void Slide::addElement(SlideElement *element)
 
 void Slide::removeElement(const int index)
 {
+	load();
+	setDirty(true);
 	delete elements.takeAt(index);
 
 	const int elementsCount = elements.size();
@@ -107,6 +159,8 @@ void Slide::removeElement(const int index)
 
 void Slide::moveElement(const int from, const int to)
 {
+	load();
+	setDirty(true);
 	elements.move(from, to);
 
 	const int elementsCount = elements.size();
@@ -125,6 +179,9 @@ PropertyList Slide::getProperties() const
 	EnumPropertyManager *enumManager = new EnumPropertyManager;
 	connect(enumManager, &PropertyManager::modified, this, &Slide::propertyChanged);
 
+	IntPropertyManager *intManager = new IntPropertyManager;
+	connect(intManager, &PropertyManager::modified, this, &Slide::propertyChanged);
+
 	Property *background = new Property(0, tr("Arrière-plan"));
 
 	Property *color = new Property(colorManager, tr("Couleur"), QStringLiteral("backgroundColor"));
@@ -144,9 +201,37 @@ PropertyList Slide::getProperties() const
 	enumManager->setEnumNames(QStringLiteral("backgroundImageStretch"), QStringList() << tr("Remplir & Conserver") << tr("Répéter") << tr("Conserver"));
 	image->addProperty(stretchMode);
 
+	Property *transitionGroup = new Property(0, tr("Transition"));
+
+	Property *transition = new Property(enumManager, tr("Effet"), QStringLiteral("transition"));
+	transition->setValue(this->getValue(QStringLiteral("transition")));
+	transition->setToolTip(tr("Effet utilisé pour afficher cette diapositive"));
+	enumManager->setEnumNames(QStringLiteral("transition"), QStringList() << tr("Aucun") << tr("Fondu") << tr("Pousser") << tr("Balayer"));
+	transitionGroup->addProperty(transition);
+
+	Property *duration = new Property(intManager, tr("Durée"), QStringLiteral("transitionDuration"));
+	duration->setValue(this->getValue(QStringLiteral("transitionDuration")));
+	duration->setToolTip(tr("Durée de l'effet de transition"));
+	intManager->setMinimum(QStringLiteral("transitionDuration"), 0);
+	intManager->setMaximum(QStringLiteral("transitionDuration"), 10000);
+	intManager->setSuffix(QStringLiteral("transitionDuration"), tr(" ms"));
+	transitionGroup->addProperty(duration);
+
+	Property *playback = new Property(0, tr("Lecture"));
+
+	Property *displayDuration = new Property(intManager, tr("Durée d'affichage"), QStringLiteral("duration"));
+	displayDuration->setValue(this->getValue(QStringLiteral("duration")));
+	displayDuration->setToolTip(tr("Durée avant de passer à la diapositive suivante en lecture automatique (0 : attendre la fin des médias)"));
+	intManager->setMinimum(QStringLiteral("duration"), 0);
+	intManager->setMaximum(QStringLiteral("duration"), 86400000);
+	intManager->setSuffix(QStringLiteral("duration"), tr(" ms"));
+	playback->addProperty(displayDuration);
+
 	return PropertyList()
 		<< SlideshowElement::getProperties()
-		<< background;
+		<< background
+		<< transitionGroup
+		<< playback;
 }
 
 Slideshow *Slide::slideshow() const
@@ -159,9 +244,129 @@ void Slide::setSlideshow(Slideshow *slideshow)
 	parentSlideshow = slideshow;
 }
 
+SlideChunk Slide::chunk() const
+{
+	return slideChunk;
+}
+
+void Slide::setChunk(const SlideChunk &chunk)
+{
+	slideChunk = chunk;
+}
+
+bool Slide::isLoaded() const
+{
+	return loaded;
+}
+
+bool Slide::load()
+{
+	return load(parentSlideshow != 0 ? parentSlideshow->source() : 0);
+}
+
+bool Slide::load(SlideshowReader *reader)
+{
+	if(loaded)
+		return true;
+
+	loaded = true;
+	if(reader == 0)
+		return false;
+
+	const bool success = reader->readSlide(slideChunk, this);
+	setDirty(false);
+	return success;
+}
+
+bool Slide::unload()
+{
+	// unsaved changes only exist in memory: they cannot be decoded again
+	if(!loaded || slideChunk.isNull() || isDirty())
+		return false;
+
+	while(!elements.isEmpty())
+		delete elements.takeFirst();
+
+	loaded = false;
+	return true;
+}
+
+SlideSnapshot Slide::snapshot() const
+{
+	SlideSnapshot snapshot;
+	snapshot.name = getValue(QStringLiteral("name")).toString();
+	if(!isDirty() && !slideChunk.isNull())
+	{
+		snapshot.chunk = slideChunk;
+		return snapshot;
+	}
+
+	snapshot.properties = getValues();
+	snapshot.assets = assets();
+	foreach(const SlideElement *element, getElements())
+		snapshot.elements << qMakePair(QByteArray(element->type()), element->getValues());
+
+	return snapshot;
+}
+
+QStringList Slide::assets() const
+{
+	QStringList paths;
+
+	const QString backgroundImage = getValue(QStringLiteral("backgroundImage")).toString();
+	if(!backgroundImage.isEmpty())
+		paths << backgroundImage;
+
+	foreach(const SlideElement *element, getElements())
+		paths << element->assets();
+
+	paths.removeDuplicates();
+	return paths;
+}
+
+int Slide::dynamicLayer() const
+{
+	// items are stacked by element index, everything below this one can be drawn once
+	foreach(const SlideElement *element, getElements())
+	{
+		if(element->isDynamic())
+			return element->getIndex();
+	}
+
+	return -1;
+}
+
+bool Slide::isDirty() const
+{
+	if(SlideshowElement::isDirty())
+		return true;
+
+	foreach(const SlideElement *element, elements)
+	{
+		if(element->isDirty())
+			return true;
+	}
+
+	return false;
+}
+
+void Slide::setDirty(const bool dirty)
+{
+	SlideshowElement::setDirty(dirty);
+	if(dirty)
+		return;
+
+	foreach(SlideElement *element, elements)
+		element->setDirty(false);
+}
+
 void Slide::elementChanged()
 {
-	emit modified();
+	SlideElement *element = qobject_cast<SlideElement *>(sender());
+	if(element != 0)
+		emit elementModified(element);
+	else
+		emit modified();
 }
 
 void Slide::elementMoved()
@@ -179,6 +384,15 @@ void Slide::updatePropertiesRequested()
 	emit updateProperties();
 }
 
+void Slide::prepare()
+{
+	foreach(SlideElement *element, elements)
+	{
+		if(element->getValue(QStringLiteral("visible")).toBool())
+			element->prepare();
+	}
+}
+
 void Slide::play()
 {
 	foreach(SlideElement *element, elements)
@@ -217,9 +431,7 @@ void Slide::toggleMute()
 
 void Slide::destroy()
 {
+	// elements hidden since they were rendered still hold their resources
 	foreach(SlideElement *element, elements)
-	{
-		if(element->getValue(QStringLiteral("visible")).toBool())
-			element->destroy();
-	}
+		element->destroy();
 }
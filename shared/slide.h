@@ -20,9 +20,12 @@
 #define SLIDE_H
 
 #include "slideshowelement.h"
+#include "slidechunk.h"
+#include "slidesnapshot.h"
 #include "shared.h"
 
 class QGraphicsScene;
+class SlideshowReader;
 class Slideshow;
 class SlideElement;
 
@@ -31,10 +34,20 @@ class CFISLIDES_DLLSPEC Slide : public SlideshowElement
 	Q_OBJECT
 
 public:
+	enum Transition
+	{
+		NoTransition,
+		Crossfade,
+		Push,
+		Wipe
+	};
+
 	explicit Slide(Slideshow *slideshow);
+	Slide(Slideshow *slideshow, const SlideChunk &chunk);
 	~Slide();
 
 	void render(QGraphicsScene *scene, const bool interactive) const;
+	void updateElement(SlideElement *element, QGraphicsScene *scene);
 	QList<SlideElement *> getElements() const;
 	SlideElement *getElement(const int index) const;
 	void addElement(SlideElement *);
@@ -43,13 +56,26 @@ public:
 	virtual PropertyList getProperties() const;
 	Slideshow *slideshow() const;
 	void setSlideshow(Slideshow *slideshow);
+	SlideChunk chunk() const;
+	void setChunk(const SlideChunk &chunk);
+	bool isLoaded() const;
+	bool load();
+	bool load(SlideshowReader *reader);
+	bool unload();
+	virtual bool isDirty() const;
+	virtual void setDirty(const bool dirty);
+	SlideSnapshot snapshot() const;
+	QStringList assets() const;
+	int dynamicLayer() const;
 
 signals:
+	void elementModified(SlideElement *element);
 	void moved();
 	void refresh();
 	void updateProperties();
 
 public slots:
+	void prepare();
 	void play();
 	void pause();
 	void stop();
@@ -72,6 +98,8 @@ private:
 	};
 	QList<SlideElement *> elements;
 	Slideshow *parentSlideshow;
+	SlideChunk slideChunk;
+	bool loaded;
 };
 
 #endif // SLIDE_H
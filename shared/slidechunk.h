@@ -0,0 +1,67 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SLIDECHUNK_H
+#define SLIDECHUNK_H
+
+#include <QString>
+#include <QStringList>
+#include <QByteArray>
+#include <QList>
+
+struct SlideChunk
+{
+	enum Encoding
+	{
+		VariantMapEncoding = 0x00,
+		DictionaryEncoding = 0x01,
+		EncodingMask = 0x0F
+	};
+
+	enum Codec
+	{
+		NoCodec = 0x00,
+		ZlibCodec = 0x10,
+		CodecMask = 0xF0
+	};
+
+	SlideChunk() : offset(-1), size(0), flags(0) {}
+	bool isNull() const { return offset < 0; }
+	int encoding() const { return flags & EncodingMask; }
+	int codec() const { return flags & CodecMask; }
+
+	qint64 offset;
+	qint32 size;
+	quint8 flags; // encoding of the properties in the low nibble, compression in the high one
+	QString name;
+	QList<QByteArray> assets; // hashes of the embedded files used by the slide
+	QStringList paths; // files used by the slide, embedded or not
+};
+
+struct SlideAsset
+{
+	SlideAsset() : offset(-1), size(0) {}
+	bool isNull() const { return offset < 0; }
+
+	QByteArray hash; // SHA-1 of the content
+	qint64 offset;
+	qint64 size;
+	QStringList paths;
+};
+
+#endif // SLIDECHUNK_H
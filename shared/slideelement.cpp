@@ -17,6 +17,7 @@
  */
 
 #include <QRect>
+#include <QGraphicsItem>
 
 #include "slideelement.h"
 #include "slide.h"
@@ -27,15 +28,58 @@
 SlideElement::SlideElement() : SlideshowElement()
 {
 	parentSlide = 0;
+	liveItem = 0;
 	setValue(QStringLiteral("visible"), true);
 }
 
 SlideElement::SlideElement(const SlideElement &copy) : SlideshowElement()
 {
 	parentSlide = 0;
+	liveItem = 0;
 	setValues(copy.getValues());
 }
 
+SlideElement::~SlideElement()
+{
+	// a removed element takes its item out of the editor scene
+	QGraphicsItem *item = liveItem;
+	liveItem = 0;
+	delete item;
+}
+
+bool SlideElement::updateItem(QGraphicsItem *item)
+{
+	Q_UNUSED(item);
+	return false;
+}
+
+QGraphicsItem *SlideElement::graphicsItem() const
+{
+	return liveItem;
+}
+
+void SlideElement::setGraphicsItem(QGraphicsItem *item)
+{
+	liveItem = item;
+}
+
+QStringList SlideElement::assets() const
+{
+	return QStringList();
+}
+
+bool SlideElement::isDynamic() const
+{
+	// the item of a static element looks the same for as long as the slide is shown
+	return false;
+}
+
+bool SlideElement::isPlaying() const
+{
+	// elements which end by themselves report it with finished()
+	return false;
+}
+
 const char *SlideElement::type() const
 {
 	return metaObject()->className();
@@ -95,6 +139,12 @@ int SlideElement::getIndex() const
 void SlideElement::setIndex(const int newIndex)
 {
 	this->elementIndex = newIndex;
+
+	if(liveItem != 0)
+	{
+		liveItem->setData(Qt::UserRole, newIndex);
+		liveItem->setZValue(newIndex);
+	}
 }
 
 Slide *SlideElement::slide() const
@@ -21,6 +21,7 @@
 
 #include <QObject>
 #include <QPoint>
+#include <QStringList>
 
 #include "slideshowelement.h"
 #include "shared.h"
@@ -36,9 +37,16 @@ class CFISLIDES_DLLSPEC SlideElement : public SlideshowElement
 public:
 	SlideElement();
 	SlideElement(const SlideElement &copy);
+	~SlideElement();
 	virtual QString previewUrl() const;
+	virtual QStringList assets() const;
 	const char *type() const;
 	virtual QGraphicsItem *render(const bool interactive) = 0;
+	virtual bool updateItem(QGraphicsItem *item);
+	virtual bool isDynamic() const;
+	virtual bool isPlaying() const;
+	QGraphicsItem *graphicsItem() const;
+	void setGraphicsItem(QGraphicsItem *item);
 	virtual PropertyList getProperties() const;
 	int getIndex() const;
 	void setIndex(const int newIndex);
@@ -55,6 +63,7 @@ signals:
 
 public slots:
 	void movedTo(QPoint);
+	virtual void prepare() {}
 	virtual void play() {}
 	virtual void pause() {}
 	virtual void stop() {}
@@ -64,6 +73,7 @@ public slots:
 private:
 	int elementIndex;
 	Slide *parentSlide;
+	QGraphicsItem *liveItem;
 };
 
 #endif // SLIDEELEMENT_H
@@ -0,0 +1,64 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QGraphicsScene>
+#include <QPainter>
+
+#include "sliderenderer.h"
+#include "slide.h"
+
+SlideRenderer::SlideRenderer(const QSize &size)
+{
+	// one scene is reused for every slide, without any view attached to it
+	scene = new QGraphicsScene;
+	scene->setSceneRect(QRect(QPoint(), size));
+	scene->setItemIndexMethod(QGraphicsScene::NoIndex);
+}
+
+SlideRenderer::~SlideRenderer()
+{
+	delete scene;
+}
+
+QImage SlideRenderer::render(const Slide *slide)
+{
+	QImage image(scene->sceneRect().size().toSize(), QImage::Format_ARGB32_Premultiplied);
+	image.fill(Qt::white);
+
+	slide->render(scene, false);
+
+	QPainter painter(&image);
+	painter.setRenderHint(QPainter::Antialiasing);
+	scene->render(&painter, scene->sceneRect());
+	painter.end();
+
+	scene->clear();
+
+	return image;
+}
+
+QString SlideRenderer::fileName(const QString &fileTemplate, const Slide *slide, const int index, const QString &slideshowName, const QString &format)
+{
+	QString fileName = fileTemplate;
+	fileName.replace("%n", slide->getValue(QStringLiteral("name")).toString());
+	fileName.replace("%i", QString::number(index + 1));
+	fileName.replace("%s", slideshowName);
+	fileName.replace("%f", format);
+
+	return fileName;
+}
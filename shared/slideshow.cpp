@@ -17,12 +17,20 @@
  */
 
 #include <QDesktopWidget>
+#include <QStandardPaths>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QDir>
+#include <QDateTime>
 
 #include "slideshow.h"
 #include "slide.h"
+#include "slideshowreader.h"
+#include "configuration.h"
 
-Slideshow::Slideshow() : BaseElement()
+Slideshow::Slideshow() : BaseElement(), images(IMAGE_CACHE_SIZE)
 {
+	reader = 0;
 	setValue(QStringLiteral("size"), QDesktopWidget().screenGeometry().size());
 }
 
@@ -30,6 +38,8 @@ Slideshow::~Slideshow()
 {
 	while(!slides.isEmpty())
 		delete slides.takeFirst();
+
+	delete reader;
 }
 
 QList<Slide *> Slideshow::getSlides() const
@@ -45,27 +55,191 @@ Slide *Slideshow::getSlide(const int index) const
 Slide *Slideshow::createSlide()
 {
 	Slide *slide = new Slide(this);
-	slides << slide;
+	addSlide(slide);
+	return slide;
+}
+
+Slide *Slideshow::createSlide(const SlideChunk &chunk)
+{
+	Slide *slide = new Slide(this, chunk);
+	addSlide(slide);
 	return slide;
 }
 
 void Slideshow::addSlide(Slide *slide)
 {
+	// appending keeps the index table in sync, reordering invalidates it
+	if(indexes.size() == slides.size())
+		indexes.insert(slide, slides.size());
 	slides << slide;
 }
 
 void Slideshow::moveSlide(const int from, const int to)
 {
 	slides.move(from, to);
+	indexes.clear();
 }
 
 int Slideshow::indexOf(Slide *s) const
 {
-	return slides.indexOf(s);
+	if(indexes.size() != slides.size())
+	{
+		indexes.clear();
+		for(int index = 0; index < slides.size(); index++)
+			indexes.insert(slides[index], index);
+	}
+
+	return indexes.value(s, -1);
 }
 
 void Slideshow::removeSlide(const int index)
 {
 	slides[index]->deleteLater();
 	slides.removeAt(index);
+	indexes.clear();
+}
+
+SlideshowReader *Slideshow::source() const
+{
+	return reader;
+}
+
+void Slideshow::resolveAssetPaths()
+{
+	// the index of older files does not list the paths used by each slide
+	if(reader == 0 || reader->version() > 5)
+		return;
+
+	foreach(Slide *slide, slides)
+	{
+		SlideChunk chunk = slide->chunk();
+		if(chunk.isNull() || slide->isDirty())
+			continue;
+
+		const bool loaded = slide->isLoaded();
+		slide->load();
+		chunk.paths = slide->assets();
+		slide->setChunk(chunk);
+		if(!loaded)
+			slide->unload();
+	}
+}
+
+SlideshowSnapshot Slideshow::snapshot() const
+{
+	SlideshowSnapshot snapshot;
+	snapshot.metadata = getValues();
+
+	if(reader != 0)
+	{
+		snapshot.sourceFile = reader->fileName();
+		snapshot.sourceVersion = reader->version();
+		snapshot.sourceHeaderSize = reader->headerSize();
+		snapshot.sourceIndexOffset = reader->indexOffset();
+		snapshot.sourceSize = reader->endOffset();
+		snapshot.sourceAssets = reader->assets();
+		snapshot.sourceDictionary = reader->dictionary().strings();
+	}
+
+	// chunks saved without their media do not list their hashes, the paths from the index are embedded now
+	const bool listAssets = getValue(QStringLiteral("embedAssets")).toBool() && (reader == 0 || !reader->metadata().value(QStringLiteral("embedAssets")).toBool());
+	foreach(const Slide *slide, slides)
+	{
+		SlideSnapshot slideSnapshot = slide->snapshot();
+		if(listAssets && !slideSnapshot.chunk.isNull())
+			slideSnapshot.assets = slideSnapshot.chunk.paths;
+		snapshot.slides << slideSnapshot;
+	}
+
+	return snapshot;
+}
+
+QByteArray Slideshow::asset(const QString &path) const
+{
+	if(reader == 0 || path.isEmpty())
+		return QByteArray();
+
+	return reader->readAsset(reader->asset(path));
+}
+
+QPixmap Slideshow::pixmap(const QString &path, const QSize &size) const
+{
+	if(path.isEmpty())
+		return QPixmap();
+
+	const QString key = imageKey(path);
+	if(!images.contains(key))
+	{
+		// the embedded copy wins so the slideshow looks the same on every computer
+		QPixmap pixmap;
+		const QByteArray data = asset(path);
+		if(data.isEmpty() || !pixmap.loadFromData(data))
+			pixmap.load(path);
+
+		if(!images.insert(key, pixmap))
+			return pixmap;
+	}
+
+	return images.pixmap(key, size);
+}
+
+QString Slideshow::imageKey(const QString &path) const
+{
+	if(path.isEmpty())
+		return QString();
+
+	// images are decoded once, embedded ones are shared by content and files are reloaded when they change
+	const SlideAsset embedded = reader != 0 ? reader->asset(path) : SlideAsset();
+	return !embedded.isNull()
+		? QString::fromLatin1(embedded.hash.toHex())
+		: path + '|' + QString::number(QFileInfo(path).lastModified().toMSecsSinceEpoch());
+}
+
+bool Slideshow::hasImage(const QString &key) const
+{
+	return images.contains(key);
+}
+
+void Slideshow::insertImage(const QString &key, const QList<QImage> &levels)
+{
+	// pixmaps can only be created on the GUI thread, images decoded elsewhere are converted here
+	if(levels.isEmpty() || !images.fits(levels.first().size(), levels.first().depth()))
+		return;
+
+	QList<QPixmap> pixmaps;
+	foreach(const QImage &level, levels)
+		pixmaps << QPixmap::fromImage(level);
+
+	images.insert(key, pixmaps);
+}
+
+QUrl Slideshow::mediaUrl(const QString &path) const
+{
+	const SlideAsset asset = reader != 0 ? reader->asset(path) : SlideAsset();
+	if(asset.isNull())
+		return QUrl::fromLocalFile(path);
+
+	// media backends need a file: embedded media are extracted once, named after their content
+	const QString cachePath = QDir(QStandardPaths::writableLocation(QStandardPaths::CacheLocation)).filePath(QStringLiteral("assets"));
+	QDir().mkpath(cachePath);
+
+	const QString fileName = QDir(cachePath).filePath(QString::fromLatin1(asset.hash.toHex()) + '.' + QFileInfo(path).suffix());
+	if(!QFile::exists(fileName))
+	{
+		const QByteArray data = reader->readAsset(asset);
+
+		QSaveFile file(fileName);
+		if(data.size() != asset.size || !file.open(QIODevice::WriteOnly) || file.write(data) != data.size() || !file.commit())
+			return QUrl::fromLocalFile(path);
+	}
+
+	return QUrl::fromLocalFile(fileName);
+}
+
+void Slideshow::setSource(SlideshowReader *reader)
+{
+	if(this->reader != reader)
+		delete this->reader;
+
+	this->reader = reader;
 }
@@ -21,11 +21,18 @@
 
 #include <QObject>
 #include <QList>
+#include <QHash>
+#include <QPixmap>
+#include <QImage>
+#include <QUrl>
 
 #include "baseelement.h"
+#include "slidesnapshot.h"
+#include "imagecache.h"
 #include "shared.h"
 
 class Slide;
+class SlideshowReader;
 
 class CFISLIDES_DLLSPEC Slideshow : public BaseElement
 {
@@ -39,13 +46,27 @@ public:
 	void setSlides(QList<Slide *>);
 	Slide *getSlide(const int index) const;
 	Slide *createSlide();
+	Slide *createSlide(const SlideChunk &chunk);
 	void addSlide(Slide *slide);
 	void moveSlide(const int from, const int to);
 	int indexOf(Slide *) const;
 	void removeSlide(const int index);
+	SlideshowReader *source() const;
+	void setSource(SlideshowReader *reader);
+	void resolveAssetPaths();
+	SlideshowSnapshot snapshot() const;
+	QByteArray asset(const QString &path) const;
+	QPixmap pixmap(const QString &path, const QSize &size = QSize()) const;
+	QString imageKey(const QString &path) const;
+	bool hasImage(const QString &key) const;
+	void insertImage(const QString &key, const QList<QImage> &levels);
+	QUrl mediaUrl(const QString &path) const;
 
 protected:
 	QList<Slide *> slides;
+	mutable QHash<Slide *, int> indexes;
+	SlideshowReader *reader;
+	mutable ImageCache images;
 };
 
 #endif // SLIDESHOW_H
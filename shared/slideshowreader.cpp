@@ -0,0 +1,423 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QCoreApplication>
+#include <QDataStream>
+
+#include "slideshowreader.h"
+#include "slide.h"
+#include "slideelement.h"
+#include "chunkcodec.h"
+#include "configuration.h"
+
+static const qint64 TRAILER_SIZE = sizeof(qint64) + sizeof(quint32);
+
+SlideshowReader::SlideshowReader(const QString &fileName, QObject *parent) : QObject(parent), file(fileName)
+{
+	mapping = 0;
+	fileVersion = 0;
+	dataStart = 0;
+	indexStart = 0;
+	fileEnd = 0;
+	lastError = NoError;
+}
+
+bool SlideshowReader::open()
+{
+	if(!file.open(QIODevice::ReadOnly))
+		return setError(OpenError);
+
+	// chunks and assets are decoded in place when the file can be mapped
+	mapping = file.map(0, file.size());
+
+	QDataStream in(&file);
+
+	quint32 magic = 0;
+	in >> magic;
+	if(magic == FILE_MAGIC)
+	{
+		quint16 version = 0;
+		in >> version;
+		if(version > FILE_VERSION)
+			return setError(VersionError);
+
+		fileVersion = version;
+		in.setVersion(QDataStream::Qt_5_0);
+	}
+	else
+	{
+		// files written before the chunked format start directly with the application name
+		file.seek(0);
+		fileVersion = 1;
+	}
+
+	QString fileAppName;
+	in >> fileAppName;
+	if(in.status() != QDataStream::Ok || fileAppName != QCoreApplication::applicationName())
+		return setError(FormatError);
+
+	dataStart = file.pos();
+	fileEnd = file.size();
+	if(fileVersion == 1)
+		return true;
+
+	if(fileEnd < dataStart + TRAILER_SIZE || !file.seek(fileEnd - TRAILER_SIZE))
+		return setError(CorruptError);
+
+	quint32 magic = 0;
+	in >> indexStart >> magic;
+	if(magic == INDEX_MAGIC && indexStart >= dataStart && indexStart <= fileEnd - TRAILER_SIZE)
+		return true;
+
+	// a save interrupted while appending leaves the previous trailer valid further back
+	const QByteArray marker("CSLI", 4);
+	const QByteArray data = region(0, fileEnd);
+	for(int position = data.lastIndexOf(marker); position >= dataStart + TRAILER_SIZE - 4; position = data.lastIndexOf(marker, position - 1))
+	{
+		if(!file.seek(position + 4 - TRAILER_SIZE))
+			break;
+
+		in >> indexStart >> magic;
+		if(magic == INDEX_MAGIC && indexStart >= dataStart && indexStart <= position + 4 - TRAILER_SIZE)
+		{
+			fileEnd = position + 4;
+			return true;
+		}
+	}
+
+	return setError(CorruptError);
+}
+
+bool SlideshowReader::readIndex()
+{
+	slideChunks.clear();
+	propertyDictionary = PropertyDictionary();
+	slideAssets.clear();
+	assetPaths.clear();
+
+	if(fileVersion == 1)
+		return readLegacyIndex();
+
+	const QByteArray index = region(indexStart, fileEnd - TRAILER_SIZE - indexStart);
+	QDataStream in(index);
+	in.setVersion(QDataStream::Qt_5_0);
+
+	in >> slideshowMetadata;
+
+	if(fileVersion > 3)
+	{
+		QStringList strings;
+		in >> strings;
+		propertyDictionary = PropertyDictionary(strings);
+	}
+
+	qint32 slidesCount = 0;
+	in >> slidesCount;
+	for(int si = 0; si < slidesCount && in.status() == QDataStream::Ok; si++)
+	{
+		SlideChunk chunk;
+		in >> chunk.offset >> chunk.size >> chunk.flags >> chunk.name;
+		if(fileVersion > 2)
+			in >> chunk.assets;
+		if(fileVersion > 5)
+			in >> chunk.paths;
+
+		if(chunk.offset < dataStart || chunk.offset + chunk.size > indexStart)
+			return setError(CorruptError);
+
+		if(chunk.encoding() > SlideChunk::DictionaryEncoding || !ChunkCodec::isSupported(chunk.codec()))
+			return setError(VersionError);
+
+		slideChunks << chunk;
+	}
+
+	qint32 assetsCount = 0;
+	if(fileVersion > 2)
+		in >> assetsCount;
+
+	for(int ai = 0; ai < assetsCount && in.status() == QDataStream::Ok; ai++)
+	{
+		SlideAsset asset;
+		in >> asset.hash >> asset.offset >> asset.size >> asset.paths;
+
+		if(asset.offset < dataStart || asset.offset + asset.size > indexStart)
+			return setError(CorruptError);
+
+		foreach(const QString &path, asset.paths)
+			assetPaths[path] = slideAssets.size();
+		slideAssets << asset;
+	}
+
+	if(in.status() != QDataStream::Ok)
+		return setError(CorruptError);
+
+	return true;
+}
+
+bool SlideshowReader::readLegacyIndex()
+{
+	// version 1 files have no index: walk the stream once to locate every slide
+	const QByteArray data = region(dataStart, file.size() - dataStart);
+	QDataStream in(data);
+	in >> slideshowMetadata;
+
+	qint32 slidesCount = 0;
+	in >> slidesCount;
+	for(int si = 0; si < slidesCount && in.status() == QDataStream::Ok; si++)
+	{
+		SlideChunk chunk;
+		chunk.offset = dataStart + in.device()->pos();
+
+		QVariantMap properties;
+		in >> properties;
+		chunk.name = properties.value(QStringLiteral("name")).toString();
+
+		qint32 elementsCount = 0;
+		in >> elementsCount;
+		for(int ei = 0; ei < elementsCount && in.status() == QDataStream::Ok; ei++)
+		{
+			char *type;
+			in >> type;
+			delete[] type;
+
+			QVariantMap properties;
+			in >> properties;
+		}
+
+		chunk.size = dataStart + in.device()->pos() - chunk.offset;
+		slideChunks << chunk;
+	}
+
+	if(in.status() != QDataStream::Ok)
+		return setError(CorruptError);
+
+	return true;
+}
+
+bool SlideshowReader::readSlide(const SlideChunk &chunk, Slide *slide)
+{
+	// every chunk is compressed on its own: only this slide has to be inflated
+	const QByteArray raw = region(chunk.offset, chunk.size);
+	if(raw.size() != chunk.size)
+		return slideError(slide);
+
+	const QByteArray data = ChunkCodec::decode(chunk.codec(), raw);
+	if(data.isEmpty())
+		return slideError(slide);
+
+	QDataStream in(data);
+	if(fileVersion > 1)
+		in.setVersion(QDataStream::Qt_5_0);
+
+	const bool compact = chunk.encoding() == SlideChunk::DictionaryEncoding;
+
+	QVariantMap properties;
+	if(compact)
+		properties = propertyDictionary.readMap(in);
+	else
+		in >> properties;
+	slide->setValues(properties);
+
+	qint32 elementsCount = 0;
+	in >> elementsCount;
+	for(int ei = 0; ei < elementsCount && in.status() == QDataStream::Ok; ei++)
+	{
+		QByteArray type;
+		QVariantMap properties;
+		if(compact)
+		{
+			quint16 typeIndex = 0;
+			in >> typeIndex;
+			type = propertyDictionary.string(typeIndex).toLatin1();
+			properties = propertyDictionary.readMap(in);
+		}
+		else
+		{
+			if(fileVersion == 1)
+			{
+				char *legacyType;
+				in >> legacyType;
+				type = legacyType;
+				delete[] legacyType;
+			}
+			else
+				in >> type;
+
+			in >> properties;
+		}
+
+		const int typeId = QMetaType::type(type.constData());
+		if(!elementTypes.contains(typeId))
+		{
+			emit unknownElement(slide->getValue(QStringLiteral("name")).toString(), QString::fromLatin1(type), ei);
+			continue;
+		}
+
+		SlideElement *element = (SlideElement *)QMetaType::create(typeId);
+		element->setValues(properties);
+		slide->addElement(element);
+	}
+
+	if(in.status() != QDataStream::Ok)
+		return slideError(slide);
+
+	return true;
+}
+
+QByteArray SlideshowReader::readChunk(const SlideChunk &chunk)
+{
+	if(chunk.isNull())
+		return QByteArray();
+
+	return region(chunk.offset, chunk.size);
+}
+
+bool SlideshowReader::slideError(const Slide *slide)
+{
+	// the slide keeps what could be decoded, the application decides how to report it
+	emit corruptSlide(slide->getValue(QStringLiteral("name")).toString());
+	return setError(CorruptError);
+}
+
+QMap<int, QString> SlideshowReader::chunkStrings(const SlideChunk &chunk, const QByteArray &data, PropertyDictionary dictionary)
+{
+	// the dictionary entries a chunk refers to, its bytes only have a meaning along with them
+	QMap<int, QString> strings;
+	if(chunk.isNull() || chunk.encoding() != SlideChunk::DictionaryEncoding)
+		return strings;
+
+	QDataStream in(ChunkCodec::decode(chunk.codec(), data));
+	in.setVersion(QDataStream::Qt_5_0);
+
+	foreach(const QString &key, dictionary.readMap(in).keys())
+		strings[dictionary.indexOf(key)] = key;
+
+	qint32 elementsCount = 0;
+	in >> elementsCount;
+	for(int ei = 0; ei < elementsCount && in.status() == QDataStream::Ok; ei++)
+	{
+		quint16 typeIndex = 0;
+		in >> typeIndex;
+		strings[typeIndex] = dictionary.string(typeIndex);
+
+		foreach(const QString &key, dictionary.readMap(in).keys())
+			strings[dictionary.indexOf(key)] = key;
+	}
+
+	return strings;
+}
+
+void SlideshowReader::close()
+{
+	// closing the file also releases the mapping
+	mapping = 0;
+	file.close();
+}
+
+QString SlideshowReader::fileName() const
+{
+	return file.fileName();
+}
+
+int SlideshowReader::version() const
+{
+	return fileVersion;
+}
+
+qint64 SlideshowReader::headerSize() const
+{
+	return dataStart;
+}
+
+qint64 SlideshowReader::indexOffset() const
+{
+	return indexStart;
+}
+
+qint64 SlideshowReader::endOffset() const
+{
+	return fileEnd;
+}
+
+SlideshowReader::Error SlideshowReader::error() const
+{
+	return lastError;
+}
+
+QVariantMap SlideshowReader::metadata() const
+{
+	return slideshowMetadata;
+}
+
+QList<SlideChunk> SlideshowReader::chunks() const
+{
+	return slideChunks;
+}
+
+PropertyDictionary SlideshowReader::dictionary() const
+{
+	return propertyDictionary;
+}
+
+QList<SlideAsset> SlideshowReader::assets() const
+{
+	return slideAssets;
+}
+
+SlideAsset SlideshowReader::asset(const QString &path) const
+{
+	const int index = assetPaths.value(path, -1);
+	if(index < 0)
+		return SlideAsset();
+
+	return slideAssets[index];
+}
+
+QByteArray SlideshowReader::readAsset(const SlideAsset &asset)
+{
+	if(asset.isNull())
+		return QByteArray();
+
+	return region(asset.offset, asset.size);
+}
+
+void SlideshowReader::setElementTypes(const QList<int> &types)
+{
+	elementTypes = types;
+}
+
+QByteArray SlideshowReader::region(const qint64 offset, const qint64 size)
+{
+	if(offset < 0 || size < 0 || offset + size > file.size())
+		return QByteArray();
+
+	// mapped bytes are only referenced: they stay valid until the reader is closed
+	if(mapping != 0)
+		return QByteArray::fromRawData(reinterpret_cast<const char *>(mapping + offset), size);
+
+	if(!file.seek(offset))
+		return QByteArray();
+
+	return file.read(size);
+}
+
+bool SlideshowReader::setError(const Error error)
+{
+	lastError = error;
+	return error == NoError;
+}
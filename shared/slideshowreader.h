@@ -0,0 +1,94 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SLIDESHOWREADER_H
+#define SLIDESHOWREADER_H
+
+#include <QObject>
+#include <QFile>
+#include <QVariantMap>
+#include <QHash>
+#include <QMap>
+
+#include "slidechunk.h"
+#include "propertydictionary.h"
+#include "shared.h"
+
+class Slide;
+
+class CFISLIDES_DLLSPEC SlideshowReader : public QObject
+{
+	Q_OBJECT
+
+public:
+	enum Error
+	{
+		NoError,
+		OpenError,
+		FormatError,
+		VersionError,
+		CorruptError
+	};
+
+	explicit SlideshowReader(const QString &fileName, QObject *parent = 0);
+	bool open();
+	bool readIndex();
+	bool readSlide(const SlideChunk &chunk, Slide *slide);
+	QByteArray readChunk(const SlideChunk &chunk);
+	static QMap<int, QString> chunkStrings(const SlideChunk &chunk, const QByteArray &data, PropertyDictionary dictionary);
+	void close();
+	QString fileName() const;
+	int version() const;
+	qint64 headerSize() const;
+	qint64 indexOffset() const;
+	qint64 endOffset() const;
+	Error error() const;
+	QVariantMap metadata() const;
+	QList<SlideChunk> chunks() const;
+	PropertyDictionary dictionary() const;
+	QList<SlideAsset> assets() const;
+	SlideAsset asset(const QString &path) const;
+	QByteArray readAsset(const SlideAsset &asset);
+	void setElementTypes(const QList<int> &types);
+
+signals:
+	void unknownElement(const QString &slideName, const QString &type, const int index);
+	void corruptSlide(const QString &slideName);
+
+private:
+	bool setError(const Error error);
+	bool slideError(const Slide *slide);
+	bool readLegacyIndex();
+	QByteArray region(const qint64 offset, const qint64 size);
+
+	QFile file;
+	uchar *mapping;
+	int fileVersion;
+	qint64 dataStart;
+	qint64 indexStart;
+	qint64 fileEnd;
+	Error lastError;
+	QVariantMap slideshowMetadata;
+	QList<SlideChunk> slideChunks;
+	PropertyDictionary propertyDictionary;
+	QList<SlideAsset> slideAssets;
+	QHash<QString, int> assetPaths;
+	QList<int> elementTypes;
+};
+
+#endif // SLIDESHOWREADER_H
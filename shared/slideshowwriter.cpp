@@ -0,0 +1,454 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <QCoreApplication>
+#include <QDataStream>
+#include <QSaveFile>
+#include <QFileInfo>
+#include <QCryptographicHash>
+#include <QHash>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include "slideshowwriter.h"
+#include "slideshowreader.h"
+#include "slideshow.h"
+#include "chunkcodec.h"
+#include "configuration.h"
+
+static bool copyData(QFile *from, QIODevice *to, const qint64 offset, qint64 size)
+{
+	if(!from->seek(offset))
+		return false;
+
+	QByteArray buffer(COPY_BUFFER_SIZE, Qt::Uninitialized);
+	while(size > 0)
+	{
+		const qint64 read = from->read(buffer.data(), qMin<qint64>(size, buffer.size()));
+		if(read <= 0 || to->write(buffer.constData(), read) != read)
+			return false;
+
+		size -= read;
+	}
+
+	return true;
+}
+
+static void cancel(QFileDevice *file, const qint64 size)
+{
+	// a new file is discarded, an interrupted append is cut back to the previous trailer
+	QSaveFile *saveFile = qobject_cast<QSaveFile *>(file);
+	if(saveFile != 0)
+		saveFile->cancelWriting();
+	else
+		file->resize(size);
+}
+
+static bool syncFile(QFileDevice *file)
+{
+	if(!file->flush())
+		return false;
+
+#ifdef Q_OS_WIN
+	return _commit(file->handle()) == 0;
+#else
+	return fsync(file->handle()) == 0;
+#endif
+}
+
+static QByteArray hashFile(const QString &path)
+{
+	QFile file(path);
+	if(path.isEmpty() || !file.open(QIODevice::ReadOnly))
+		return QByteArray();
+
+	QCryptographicHash hash(QCryptographicHash::Sha1);
+	if(!hash.addData(&file))
+		return QByteArray();
+
+	return hash.result();
+}
+
+static QByteArray transcodeLegacyChunk(const QByteArray &data)
+{
+	// version 1 chunks only differ by the encoding of the element types
+	QDataStream in(data);
+	QByteArray result;
+	QDataStream out(&result, QIODevice::WriteOnly);
+	out.setVersion(QDataStream::Qt_5_0);
+
+	QVariantMap properties;
+	in >> properties;
+	out << properties;
+
+	qint32 elementsCount = 0;
+	in >> elementsCount;
+	out << elementsCount;
+	for(int ei = 0; ei < elementsCount && in.status() == QDataStream::Ok; ei++)
+	{
+		char *type;
+		in >> type;
+		out << QByteArray(type);
+		delete[] type;
+
+		QVariantMap properties;
+		in >> properties;
+		out << properties;
+	}
+
+	if(in.status() != QDataStream::Ok)
+		return QByteArray();
+
+	return result;
+}
+
+SlideshowWriter::SlideshowWriter(const QString &fileName, QObject *parent) : QObject(parent)
+{
+	this->fileName = fileName;
+}
+
+bool SlideshowWriter::write(const Slideshow *slideshow)
+{
+	SlideshowReader *source = slideshow->source();
+	if(source != 0 && QFileInfo(source->fileName()) != QFileInfo(fileName))
+		source = 0;
+
+	return write(slideshow->snapshot(), source);
+}
+
+bool SlideshowWriter::write(const SlideshowSnapshot &snapshot)
+{
+	return write(snapshot, 0);
+}
+
+bool SlideshowWriter::write(const SlideshowSnapshot &snapshot, SlideshowReader *source)
+{
+	// some platforms refuse to resize or replace a file which is still open
+	if(source != 0)
+		source->close();
+
+	const bool success = writeFile(snapshot);
+	if(!success && source != 0)
+		source->open();
+
+	return success;
+}
+
+bool SlideshowWriter::writeFile(const SlideshowSnapshot &snapshot)
+{
+	// unchanged chunks are copied from the source file without being decoded
+	QFile base(snapshot.sourceFile);
+	const bool reuse = !snapshot.sourceFile.isEmpty() && base.open(QIODevice::ReadOnly);
+	const bool legacy = snapshot.sourceVersion < 2;
+
+	// copied chunks refer to the strings of the source dictionary, which is only ever extended
+	PropertyDictionary dictionary;
+	if(reuse)
+		dictionary = PropertyDictionary(snapshot.sourceDictionary);
+
+	int codec = snapshot.metadata.value(QStringLiteral("compression")).toInt() & SlideChunk::CodecMask;
+	if(!ChunkCodec::isSupported(codec))
+		codec = SlideChunk::NoCodec;
+
+	QHash<QByteArray, SlideAsset> sourceAssets;
+	QHash<QString, QByteArray> sourcePaths;
+	foreach(const SlideAsset &asset, snapshot.sourceAssets)
+	{
+		sourceAssets[asset.hash] = asset;
+		foreach(const QString &path, asset.paths)
+			sourcePaths[path] = asset.hash;
+	}
+
+	// embedded files are stored once, addressed by the hash of their content
+	const bool embed = snapshot.metadata.value(QStringLiteral("embedAssets")).toBool();
+	QList<QByteArray> assetOrder;
+	QHash<QByteArray, SlideAsset> assets;
+	QHash<QByteArray, QString> diskFiles;
+	QList<QList<QByteArray> > slideAssets;
+	foreach(const SlideSnapshot &slide, snapshot.slides)
+	{
+		QList<QByteArray> hashes;
+		if(embed && !slide.chunk.isNull() && slide.assets.isEmpty())
+		{
+			foreach(const QByteArray &hash, slide.chunk.assets)
+			{
+				if(!sourceAssets.contains(hash))
+					continue;
+
+				if(!assets.contains(hash))
+				{
+					assets[hash].hash = hash;
+					assets[hash].paths = sourceAssets[hash].paths;
+				}
+				hashes << hash;
+			}
+		}
+		else if(embed)
+		{
+			foreach(const QString &path, slide.assets)
+			{
+				QByteArray hash = hashFile(path);
+				if(hash.isEmpty())
+					hash = sourcePaths.value(path);
+				else if(!sourceAssets.contains(hash))
+					diskFiles.insert(hash, path);
+
+				if(hash.isEmpty())
+					continue;
+
+				if(!assets.contains(hash))
+					assets[hash].hash = hash;
+				if(!assets[hash].paths.contains(path))
+					assets[hash].paths << path;
+				hashes << hash;
+			}
+		}
+
+		foreach(const QByteArray &hash, hashes)
+		{
+			if(!assetOrder.contains(hash))
+				assetOrder << hash;
+		}
+		slideAssets << hashes;
+	}
+
+	// appending to the previous data region is only worth it while most of it is still used
+	qint64 liveSize = 0;
+	foreach(const SlideSnapshot &slide, snapshot.slides)
+	{
+		if(!slide.chunk.isNull() && slide.chunk.codec() == codec)
+			liveSize += slide.chunk.size;
+	}
+	foreach(const QByteArray &hash, assetOrder)
+		liveSize += sourceAssets.value(hash).size;
+
+	// files of the current version are appended in place: the cost of a save follows the edit, not the deck
+	const qint64 dataSize = snapshot.sourceIndexOffset - snapshot.sourceHeaderSize;
+	const bool append = reuse && snapshot.sourceVersion == FILE_VERSION && QFileInfo(snapshot.sourceFile) == QFileInfo(fileName) && liveSize >= dataSize * COMPACT_RATIO;
+
+	QSaveFile saveFile(fileName);
+	QFile appendFile(fileName);
+	QFileDevice &file = append ? static_cast<QFileDevice &>(appendFile) : static_cast<QFileDevice &>(saveFile);
+
+	QDataStream out(&file);
+	out.setVersion(QDataStream::Qt_5_0);
+
+	if(append)
+	{
+		// a tail left by an interrupted append is dropped, the previous index and trailer stay in the data region
+		if(!appendFile.open(QIODevice::ReadWrite) || !appendFile.resize(snapshot.sourceSize) || !appendFile.seek(snapshot.sourceSize))
+			return false;
+	}
+	else
+	{
+		if(!saveFile.open(QIODevice::WriteOnly))
+			return false;
+
+		out << quint32(FILE_MAGIC) << quint16(FILE_VERSION) << QCoreApplication::applicationName();
+	}
+
+	slideChunks.clear();
+	for(int si = 0; si < snapshot.slides.size(); si++)
+	{
+		const SlideSnapshot &slide = snapshot.slides[si];
+		SlideChunk chunk = slide.chunk;
+		if(!chunk.isNull() && !reuse)
+		{
+			// the content of unchanged slides only exists in the source file
+			cancel(&file, snapshot.sourceSize);
+			return false;
+		}
+		else if(chunk.isNull())
+		{
+			const QByteArray data = ChunkCodec::encode(codec, encodeSlide(slide, &dictionary, &chunk.flags));
+			if(data.isEmpty())
+			{
+				cancel(&file, snapshot.sourceSize);
+				return false;
+			}
+
+			chunk.offset = file.pos();
+			chunk.size = data.size();
+			chunk.flags |= codec;
+			chunk.paths = slide.assets;
+			out.writeRawData(data.constData(), data.size());
+		}
+		else if(legacy || chunk.codec() != codec)
+		{
+			if(!base.seek(chunk.offset))
+			{
+				cancel(&file, snapshot.sourceSize);
+				return false;
+			}
+
+			// only the compression changes: the properties are not decoded
+			QByteArray data = base.read(chunk.size);
+			data = legacy ? transcodeLegacyChunk(data) : ChunkCodec::decode(chunk.codec(), data);
+			data = ChunkCodec::encode(codec, data);
+			if(data.isEmpty())
+			{
+				cancel(&file, snapshot.sourceSize);
+				return false;
+			}
+
+			chunk.offset = file.pos();
+			chunk.size = data.size();
+			chunk.flags = chunk.encoding() | codec;
+			out.writeRawData(data.constData(), data.size());
+		}
+		else if(!append)
+		{
+			const qint64 offset = file.pos();
+			if(!copyData(&base, &file, chunk.offset, chunk.size))
+			{
+				cancel(&file, snapshot.sourceSize);
+				return false;
+			}
+			chunk.offset = offset;
+		}
+
+		chunk.name = slide.name;
+		chunk.assets = slideAssets[si];
+		slideChunks << chunk;
+	}
+
+	foreach(const QByteArray &hash, assetOrder)
+	{
+		SlideAsset &asset = assets[hash];
+		const SlideAsset previous = sourceAssets.value(hash);
+		if(!previous.isNull() && reuse)
+		{
+			asset.size = previous.size;
+			if(append)
+			{
+				asset.offset = previous.offset;
+				continue;
+			}
+
+			asset.offset = file.pos();
+			if(!copyData(&base, &file, previous.offset, previous.size))
+			{
+				cancel(&file, snapshot.sourceSize);
+				return false;
+			}
+		}
+		else if(diskFiles.contains(hash))
+		{
+			QFile input(diskFiles[hash]);
+			if(!input.open(QIODevice::ReadOnly))
+			{
+				cancel(&file, snapshot.sourceSize);
+				return false;
+			}
+
+			asset.offset = file.pos();
+			asset.size = input.size();
+			if(!copyData(&input, &file, 0, asset.size))
+			{
+				cancel(&file, snapshot.sourceSize);
+				return false;
+			}
+		}
+	}
+
+	const qint64 indexOffset = file.pos();
+	out << snapshot.metadata;
+	out << dictionary.strings();
+	out << qint32(slideChunks.size());
+	foreach(const SlideChunk &chunk, slideChunks)
+		out << chunk.offset << chunk.size << chunk.flags << chunk.name << chunk.assets << chunk.paths;
+
+	// files which could be found neither on disk nor in the source are left out
+	QList<SlideAsset> writtenAssets;
+	foreach(const QByteArray &hash, assetOrder)
+	{
+		if(!assets[hash].isNull())
+			writtenAssets << assets[hash];
+	}
+
+	out << qint32(writtenAssets.size());
+	foreach(const SlideAsset &asset, writtenAssets)
+		out << asset.hash << asset.offset << asset.size << asset.paths;
+
+	base.close();
+
+	if(append)
+	{
+		// the new trailer is only written once everything it points to is on disk
+		bool success = out.status() == QDataStream::Ok && syncFile(&appendFile);
+		if(success)
+		{
+			out << indexOffset << quint32(INDEX_MAGIC);
+			success = out.status() == QDataStream::Ok && syncFile(&appendFile);
+		}
+
+		if(!success)
+			cancel(&appendFile, snapshot.sourceSize);
+		return success;
+	}
+
+	out << indexOffset << quint32(INDEX_MAGIC);
+	return saveFile.commit();
+}
+
+QList<SlideChunk> SlideshowWriter::chunks() const
+{
+	return slideChunks;
+}
+
+QByteArray SlideshowWriter::encodeSlide(const SlideSnapshot &slide, PropertyDictionary *dictionary, quint8 *flags) const
+{
+	QByteArray data;
+	QDataStream out(&data, QIODevice::WriteOnly);
+	out.setVersion(QDataStream::Qt_5_0);
+
+	// keys and types are stored as indexes in the file dictionary
+	bool compact = dictionary->writeMap(out, slide.properties);
+	out << qint32(slide.elements.size());
+	for(int ei = 0; ei < slide.elements.size() && compact; ei++)
+	{
+		const int typeIndex = dictionary->indexOf(QString::fromLatin1(slide.elements[ei].first));
+		compact = typeIndex != -1;
+		out << quint16(typeIndex);
+		compact = compact && dictionary->writeMap(out, slide.elements[ei].second);
+	}
+
+	if(compact)
+	{
+		*flags = SlideChunk::DictionaryEncoding;
+		return data;
+	}
+
+	// the dictionary is full: fall back to the self-describing encoding
+	*flags = SlideChunk::VariantMapEncoding;
+
+	QByteArray variantData;
+	QDataStream variantOut(&variantData, QIODevice::WriteOnly);
+	variantOut.setVersion(QDataStream::Qt_5_0);
+
+	variantOut << slide.properties;
+	variantOut << qint32(slide.elements.size());
+	for(int ei = 0; ei < slide.elements.size(); ei++)
+		variantOut << slide.elements[ei].first << slide.elements[ei].second;
+
+	return variantData;
+}
@@ -0,0 +1,51 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SLIDESHOWWRITER_H
+#define SLIDESHOWWRITER_H
+
+#include <QObject>
+
+#include "slidechunk.h"
+#include "slidesnapshot.h"
+#include "propertydictionary.h"
+#include "shared.h"
+
+class Slideshow;
+class SlideshowReader;
+
+class CFISLIDES_DLLSPEC SlideshowWriter : public QObject
+{
+	Q_OBJECT
+
+public:
+	explicit SlideshowWriter(const QString &fileName, QObject *parent = 0);
+	bool write(const Slideshow *slideshow);
+	bool write(const SlideshowSnapshot &snapshot);
+	QList<SlideChunk> chunks() const;
+
+private:
+	bool write(const SlideshowSnapshot &snapshot, SlideshowReader *source);
+	bool writeFile(const SlideshowSnapshot &snapshot);
+	QByteArray encodeSlide(const SlideSnapshot &slide, PropertyDictionary *dictionary, quint8 *flags) const;
+
+	QString fileName;
+	QList<SlideChunk> slideChunks;
+};
+
+#endif // SLIDESHOWWRITER_H
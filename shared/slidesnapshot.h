@@ -0,0 +1,56 @@
+/**
+ * Copyright (C) 2013  Christian Fillion
+ * This file is part of cfiSlides.
+ *
+ * cfiSlides is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * cfiSlides is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with cfiSlides.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef SLIDESNAPSHOT_H
+#define SLIDESNAPSHOT_H
+
+#include <QByteArray>
+#include <QList>
+#include <QPair>
+#include <QVariantMap>
+#include <QStringList>
+
+#include "slidechunk.h"
+
+// Property maps are implicitly shared: taking a snapshot only copies
+// references, so it can be done on the GUI thread and encoded elsewhere.
+struct SlideSnapshot
+{
+	SlideChunk chunk; // null when the slide has to be encoded again
+	QString name;
+	QVariantMap properties;
+	QList<QPair<QByteArray, QVariantMap> > elements;
+	QStringList assets;
+};
+
+struct SlideshowSnapshot
+{
+	SlideshowSnapshot() : sourceVersion(0), sourceHeaderSize(0), sourceIndexOffset(0), sourceSize(0) {}
+
+	QVariantMap metadata;
+	QList<SlideSnapshot> slides;
+	QList<SlideAsset> sourceAssets;
+	QStringList sourceDictionary;
+	QString sourceFile;
+	int sourceVersion;
+	qint64 sourceHeaderSize;
+	qint64 sourceIndexOffset;
+	qint64 sourceSize;
+};
+
+#endif // SLIDESNAPSHOT_H